@@ -150,6 +150,9 @@ if __name__ == '__main__':
                     'src/sdbus/sd_bus_internals_funcs.c',
                     'src/sdbus/sd_bus_internals_interface.c',
                     'src/sdbus/sd_bus_internals_message.c',
+                    'src/sdbus/sd_bus_internals_pending_call.c',
+                    'src/sdbus/sd_bus_internals_signature.c',
+                    'src/sdbus/sd_bus_internals_string_cache.c',
                 ],
                 extra_compile_args=compile_arguments,
                 extra_link_args=link_arguments,
@@ -57,6 +57,7 @@ from .dbus_exceptions import (
     DbusUnknownObjectError,
     DbusUnknownPropertyError,
 )
+from .dbus_peer_server import DbusPeerServer
 from .dbus_proxy_async_interfaces import (
     DbusInterfaceCommonAsync,
     DbusObjectManagerInterfaceAsync,
@@ -95,6 +96,8 @@ from .sd_bus_internals import (
     encode_object_path,
     map_exception_to_dbus_error,
     sd_bus_open,
+    sd_bus_open_peer_address,
+    sd_bus_open_peer_fd,
     sd_bus_open_system,
     sd_bus_open_system_machine,
     sd_bus_open_system_remote,
@@ -129,6 +132,7 @@ __all__ = (
 
     'DbusInterfaceCommonAsync',
     'DbusObjectManagerInterfaceAsync',
+    'DbusPeerServer',
 
     'dbus_method_async',
     'dbus_method_async_override',
@@ -163,6 +167,8 @@ __all__ = (
     'encode_object_path',
     'map_exception_to_dbus_error',
     'sd_bus_open',
+    'sd_bus_open_peer_address',
+    'sd_bus_open_peer_fd',
     'sd_bus_open_system',
     'sd_bus_open_system_machine',
     'sd_bus_open_system_remote',
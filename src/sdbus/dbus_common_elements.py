@@ -30,6 +30,7 @@ from .dbus_common_funcs import (
 from .sd_bus_internals import is_interface_name_valid, is_member_name_valid
 
 if TYPE_CHECKING:
+    from asyncio import AbstractEventLoop, Handle
     from types import FunctionType
     from typing import (
         Any,
@@ -121,7 +122,8 @@ class DbusMethodCommon(DbusSomethingCommon):
             input_args_names: Optional[Sequence[str]],
             result_signature: str,
             result_args_names: Optional[Sequence[str]],
-            flags: int):
+            flags: int,
+            timeout_usec: int = 0):
 
         assert not isinstance(input_args_names, str), (
             "Passed a string as input args"
@@ -173,6 +175,8 @@ class DbusMethodCommon(DbusSomethingCommon):
             self.result_args_names = result_args_names
 
         self.flags = flags
+        # Per method call timeout, 0 uses bus default
+        self.timeout_usec = timeout_usec
 
         self.__doc__ = original_method.__doc__
 
@@ -335,6 +339,98 @@ class DbusLocalObjectMeta:
         self.activated_interfaces: List[SdBusInterface] = []
         self.serving_object_path: Optional[str] = None
         self.attached_bus: Optional[SdBus] = None
+        # Exports on peer to peer connections of DbusPeerServer
+        self.peer_buses_interfaces: Dict[SdBus, List[SdBusInterface]] = {}
+        self.properties_changes = DbusLocalPropertiesChanges()
+
+
+class DbusLocalPropertiesChanges:
+    # Property changes of local object waiting to be emitted
+    # as one PropertiesChanged signal per interface
+    def __init__(self) -> None:
+        # Interface name -> property name -> (signature, value, invalidate)
+        self.pending: Dict[str, Dict[str, Tuple[str, Any, bool]]] = {}
+        self.last_emitted: Dict[Tuple[str, str], Any] = {}
+        self.emit_handle: Optional[Handle] = None
+        self.emit_loop: Optional[AbstractEventLoop] = None
+
+    @staticmethod
+    def _is_comparable(value: Any) -> bool:
+        # Mutable values can be changed in place and
+        # can't be compared with the emitted ones
+        return isinstance(value, (str, int, float, bytes))
+
+    def add(
+        self,
+        interface_name: str,
+        property_name: str,
+        signature: str,
+        new_value: Any,
+        invalidate: bool,
+    ) -> bool:
+        """Returns True if the change needs to be emitted"""
+        interface_pending = self.pending.setdefault(interface_name, {})
+        interface_pending.pop(property_name, None)
+
+        if self._is_comparable(new_value):
+            try:
+                last_value = self.last_emitted[(interface_name, property_name)]
+            except KeyError:
+                ...
+            else:
+                if type(last_value) is type(new_value) and (
+                        last_value == new_value):
+                    return False
+
+        interface_pending[property_name] = (signature, new_value, invalidate)
+        return True
+
+    def is_emit_scheduled(self, loop: AbstractEventLoop) -> bool:
+        # Emit scheduled on a loop that was stopped and closed
+        # or replaced by another loop would never run
+        return (
+            self.emit_handle is not None
+            and not self.emit_handle.cancelled()
+            and self.emit_loop is loop
+            and not loop.is_closed()
+        )
+
+    def set_emit_handle(
+        self,
+        emit_handle: Handle,
+        loop: AbstractEventLoop,
+    ) -> None:
+        self.emit_handle = emit_handle
+        self.emit_loop = loop
+
+    def pop_signals(self) -> List[
+            Tuple[str, Dict[str, Tuple[str, Any]], List[str]]]:
+        signals: List[Tuple[str, Dict[str, Tuple[str, Any]], List[str]]] = []
+        for interface_name, interface_pending in self.pending.items():
+            if not interface_pending:
+                continue
+
+            changed: Dict[str, Tuple[str, Any]] = {}
+            invalidated: List[str] = []
+            for property_name, (signature, new_value, invalidate) in (
+                    interface_pending.items()):
+                if invalidate:
+                    invalidated.append(property_name)
+                else:
+                    changed[property_name] = (signature, new_value)
+
+                last_key = (interface_name, property_name)
+                if self._is_comparable(new_value):
+                    self.last_emitted[last_key] = new_value
+                else:
+                    self.last_emitted.pop(last_key, None)
+
+            signals.append((interface_name, changed, invalidated))
+
+        self.pending.clear()
+        self.emit_handle = None
+        self.emit_loop = None
+        return signals
 
 
 class DbusClassMeta:
@@ -0,0 +1,151 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Copyright (C) 2026 igo95862
+
+# This file is part of python-sdbus
+
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+from __future__ import annotations
+
+from asyncio import get_running_loop
+from os import getuid, unlink
+from socket import AF_UNIX, SO_PEERCRED, SOCK_STREAM, SOL_SOCKET, socket
+from struct import calcsize, unpack
+from typing import TYPE_CHECKING
+
+from .dbus_proxy_async_interfaces import DbusObjectManagerInterfaceAsync
+from .sd_bus_internals import sd_bus_open_peer_fd
+
+if TYPE_CHECKING:
+    from asyncio import Task
+    from typing import Dict, Iterable, List, Mapping, Optional, Set
+
+    from .dbus_proxy_async_interface_base import DbusInterfaceBaseAsync
+    from .sd_bus_internals import SdBus, SdBusMessage, SdBusSlot
+
+
+class DbusPeerServer:
+    def __init__(
+        self,
+        exported_objects: Mapping[str, DbusInterfaceBaseAsync],
+        allowed_uids: Optional[Iterable[int]] = None,
+    ) -> None:
+        self.exported_objects = dict(exported_objects)
+        # sd-bus leaves checking the uid of the peer to the server
+        self.allowed_uids = (
+            {getuid()} if allowed_uids is None else set(allowed_uids)
+        )
+        # Disconnect match and object manager slots of every connection
+        self._connections_slots: Dict[SdBus, List[SdBusSlot]] = {}
+        # Connections are set up while the server keeps accepting
+        self._accepting_tasks: Set[Task[None]] = set()
+
+    @property
+    def connections(self) -> List[SdBus]:
+        return list(self._connections_slots)
+
+    async def serve_unix_socket(self, socket_path: str) -> None:
+        with socket(AF_UNIX, SOCK_STREAM) as listening_socket:
+            listening_socket.bind(socket_path)
+            listening_socket.listen()
+            listening_socket.setblocking(False)
+
+            loop = get_running_loop()
+            try:
+                while True:
+                    accepted_socket, _ = await loop.sock_accept(
+                        listening_socket)
+                    accepting_task = loop.create_task(
+                        self._accept_connection(accepted_socket))
+                    self._accepting_tasks.add(accepting_task)
+                    accepting_task.add_done_callback(
+                        self._accepting_tasks.discard)
+            finally:
+                for accepting_task in self._accepting_tasks:
+                    accepting_task.cancel()
+                unlink(socket_path)
+
+    async def _accept_connection(self, accepted_socket: socket) -> None:
+        # Failed client must not stop the server
+        try:
+            with accepted_socket:
+                self._check_peer_uid(accepted_socket)
+                await self.add_connection(accepted_socket)
+        except Exception as exc:
+            get_running_loop().call_exception_handler({
+                'message': 'Failed to accept D-Bus peer connection',
+                'exception': exc,
+            })
+
+    def _check_peer_uid(self, accepted_socket: socket) -> None:
+        peer_credentials_format = '3i'
+        _, peer_uid, _ = unpack(
+            peer_credentials_format,
+            accepted_socket.getsockopt(
+                SOL_SOCKET, SO_PEERCRED, calcsize(peer_credentials_format),
+            ),
+        )
+        if peer_uid not in self.allowed_uids:
+            raise PermissionError(
+                f"Peer uid {peer_uid} is not allowed to connect")
+
+    async def add_connection(self, connected_socket: socket) -> SdBus:
+        new_bus = sd_bus_open_peer_fd(connected_socket.fileno(), server=True)
+
+        def disconnected_callback(message: SdBusMessage) -> None:
+            self._remove_connection(new_bus)
+
+        try:
+            connection_slots = [
+                await new_bus.match_signal_async(
+                    None,
+                    '/org/freedesktop/DBus/Local',
+                    'org.freedesktop.DBus.Local',
+                    'Disconnected',
+                    disconnected_callback,
+                )
+            ]
+            self._connections_slots[new_bus] = connection_slots
+
+            for object_path, exported_object in (
+                    self.exported_objects.items()):
+                exported_object._export_to_peer_bus(object_path, new_bus)
+                if isinstance(
+                        exported_object, DbusObjectManagerInterfaceAsync):
+                    connection_slots.append(
+                        new_bus.add_object_manager(object_path))
+        except BaseException:
+            # Objects exported before the failure are removed
+            self._remove_connection(new_bus)
+            new_bus.close()
+            raise
+
+        return new_bus
+
+    def _remove_connection(self, bus: SdBus) -> None:
+        connection_slots = self._connections_slots.pop(bus, None)
+        if connection_slots is None:
+            return
+
+        for exported_object in self.exported_objects.values():
+            exported_object._unexport_from_peer_bus(bus)
+
+        for slot in connection_slots:
+            slot.close()
+
+    def close(self) -> None:
+        for bus in self.connections:
+            self._remove_connection(bus)
+            bus.close()
@@ -42,6 +42,7 @@ from .dbus_proxy_async_method import (
     DbusMethodAsyncLocalBind,
 )
 from .dbus_proxy_async_property import (
+    DbusPropertiesSnapshotAsync,
     DbusPropertyAsync,
     DbusPropertyAsyncClassBind,
     DbusPropertyAsyncLocalBind,
@@ -106,6 +107,12 @@ class DbusInterfaceMetaAsync(DbusInterfaceMetaCommon):
                 dbus_class_meta.python_attr_to_dbus_member[
                     attr_name] = attr.method_name
             elif isinstance(attr, DbusPropertyAsync):
+                if attr.native and attr.property_setter is None:
+                    # Getter would keep returning the old value
+                    raise TypeError(
+                        f"Native property {attr_name!r} requires "
+                        "private setter"
+                    )
                 dbus_class_meta.dbus_member_to_python_attr[
                     attr.property_name] = attr_name
                 dbus_class_meta.python_attr_to_dbus_member[
@@ -245,11 +252,55 @@ class DbusInterfaceBaseAsync(metaclass=DbusInterfaceMetaAsync):
                 "This limitation should be fixed in future version."
             )
 
+        if local_object_meta.serving_object_path not in (None, object_path):
+            raise RuntimeError(
+                "Object already exported on a different path."
+            )
+
         if bus is None:
             bus = get_default_bus()
 
         local_object_meta.attached_bus = bus
         local_object_meta.serving_object_path = object_path
+
+        for interface_name, new_interface in self._dbus_new_interfaces():
+            bus.add_interface(new_interface, object_path,
+                              interface_name)
+            local_object_meta.activated_interfaces.append(new_interface)
+
+    def _export_to_peer_bus(
+        self,
+        object_path: str,
+        bus: SdBus,
+    ) -> None:
+        local_object_meta = self._dbus
+        if isinstance(local_object_meta, DbusRemoteObjectMeta):
+            raise RuntimeError("Cannot export D-Bus proxies.")
+
+        if local_object_meta.serving_object_path not in (None, object_path):
+            raise RuntimeError(
+                "Object already exported on a different path."
+            )
+
+        if bus in local_object_meta.peer_buses_interfaces:
+            raise RuntimeError("Object already exported on this bus.")
+
+        local_object_meta.serving_object_path = object_path
+        peer_interfaces: List[SdBusInterface] = []
+        for interface_name, new_interface in self._dbus_new_interfaces():
+            bus.add_interface(new_interface, object_path,
+                              interface_name)
+            peer_interfaces.append(new_interface)
+
+        local_object_meta.peer_buses_interfaces[bus] = peer_interfaces
+
+    def _unexport_from_peer_bus(self, bus: SdBus) -> None:
+        local_object_meta = self._dbus
+        assert isinstance(local_object_meta, DbusLocalObjectMeta)
+        # Dropping the interfaces removes them from the bus
+        local_object_meta.peer_buses_interfaces.pop(bus, None)
+
+    def _dbus_new_interfaces(self) -> List[Tuple[str, SdBusInterface]]:
         # TODO: can be optimized with a single loop
         interface_map: Dict[str, List[DbusBindedAsync]] = {}
 
@@ -279,8 +330,10 @@ class DbusInterfaceBaseAsync(metaclass=DbusInterfaceMetaAsync):
 
             interface_member_list.append(value)
 
+        new_interfaces: List[Tuple[str, SdBusInterface]] = []
         for interface_name, member_list in interface_map.items():
             new_interface = SdBusInterface()
+            properties_snapshot = DbusPropertiesSnapshotAsync(self)
             for dbus_something in member_list:
                 if isinstance(dbus_something, DbusMethodAsyncLocalBind):
                     new_interface.add_method(
@@ -293,8 +346,18 @@ class DbusInterfaceBaseAsync(metaclass=DbusInterfaceMetaAsync):
                         dbus_something._dbus_reply_call,
                     )
                 elif isinstance(dbus_something, DbusPropertyAsyncLocalBind):
-                    getter = dbus_something._dbus_reply_get
                     dbus_property = dbus_something.dbus_property
+                    if dbus_property.native:
+                        new_interface.add_native_property(
+                            dbus_property.property_name,
+                            dbus_property.property_signature,
+                            dbus_property.property_getter(self),
+                            dbus_property.flags,
+                        )
+                        continue
+
+                    properties_snapshot.add_property(dbus_property)
+                    getter = dbus_something._dbus_reply_get
 
                     if (
                         dbus_property.property_setter is not None
@@ -322,9 +385,12 @@ class DbusInterfaceBaseAsync(metaclass=DbusInterfaceMetaAsync):
                 else:
                     raise TypeError
 
-            bus.add_interface(new_interface, object_path,
-                              interface_name)
-            local_object_meta.activated_interfaces.append(new_interface)
+            if properties_snapshot.property_getters:
+                new_interface.set_properties_snapshot(properties_snapshot)
+
+            new_interfaces.append((interface_name, new_interface))
+
+        return new_interfaces
 
     def _connect(
         self,
@@ -21,6 +21,7 @@ from __future__ import annotations
 
 from typing import TYPE_CHECKING
 
+from .dbus_common_elements import DbusRemoteObjectMeta
 from .dbus_common_funcs import _parse_properties_vardict, get_default_bus
 from .dbus_proxy_async_interface_base import DbusInterfaceBaseAsync
 from .dbus_proxy_async_method import dbus_method_async
@@ -87,8 +88,29 @@ class DbusPropertiesInterfaceAsync(
     ) -> Dict[str, Any]:
 
         properties: Dict[str, Any] = {}
+        dbus_meta = self._dbus
 
         for interface_name in self._dbus_meta.dbus_interfaces_names:
+            if isinstance(dbus_meta, DbusRemoteObjectMeta):
+                # Decode reply directly in to translated properties dict
+                bus = dbus_meta.attached_bus
+                get_all_message = bus.new_method_call_message(
+                    dbus_meta.service_name,
+                    dbus_meta.object_path,
+                    'org.freedesktop.DBus.Properties',
+                    'GetAll',
+                )
+                get_all_message.append_data('s', interface_name)
+                reply_message = await bus.call_async(get_all_message)
+
+                properties.update(
+                    reply_message.read_properties_dict(
+                        name_map=self._dbus_meta.dbus_member_to_python_attr,
+                        on_unknown_member=on_unknown_member,
+                    )
+                )
+                continue
+
             dbus_properties_data = await self._properties_get_all(
                 interface_name)
 
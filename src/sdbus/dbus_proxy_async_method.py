@@ -86,7 +86,10 @@ class DbusMethodAsyncProxyBind(DbusMethodAsyncBaseBind):
 
     async def _dbus_async_call(self, call_message: SdBusMessage) -> Any:
         bus = self.proxy_meta.attached_bus
-        reply_message = await bus.call_async(call_message)
+        reply_message = await bus.call_async(
+            call_message,
+            timeout_usec=self.dbus_method.timeout_usec,
+        )
         return reply_message.get_contents()
 
     @staticmethod
@@ -234,6 +237,7 @@ def dbus_method_async(
     result_args_names: Optional[Sequence[str]] = None,
     input_args_names: Optional[Sequence[str]] = None,
     method_name: Optional[str] = None,
+    timeout_usec: int = 0,
 ) -> Callable[[T], T]:
 
     assert not isinstance(input_signature, FunctionType), (
@@ -255,6 +259,7 @@ def dbus_method_async(
             result_args_names=result_args_names,
             input_args_names=input_args_names,
             flags=flags,
+            timeout_usec=timeout_usec,
         )
 
         return cast(T, new_wrapper)
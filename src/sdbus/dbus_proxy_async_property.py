@@ -19,22 +19,40 @@
 # Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
 from __future__ import annotations
 
+from asyncio import get_running_loop
 from inspect import iscoroutinefunction
+from itertools import chain
 from types import FunctionType
 from typing import TYPE_CHECKING, Awaitable, Generic, TypeVar, cast
 from weakref import ref as weak_ref
 
 from .dbus_common_elements import (
     DbusBindedAsync,
+    DbusLocalObjectMeta,
     DbusOverload,
     DbusPropertyCommon,
     DbusRemoteObjectMeta,
     DbusSomethingAsync,
 )
+from .sd_bus_internals import (
+    DbusHiddenFlag,
+    DbusPropertyEmitsInvalidationFlag,
+    DbusPropertyExplicitFlag,
+)
 
 if TYPE_CHECKING:
-    from typing import Any, Callable, Generator, Optional, Type
+    from typing import (
+        Any,
+        Callable,
+        Dict,
+        Generator,
+        List,
+        Optional,
+        Tuple,
+        Type,
+    )
 
+    from .dbus_common_elements import DbusLocalPropertiesChanges
     from .dbus_proxy_async_interface_base import DbusInterfaceBaseAsync
     from .sd_bus_internals import SdBusMessage
 
@@ -53,6 +71,7 @@ class DbusPropertyAsync(DbusSomethingAsync, DbusPropertyCommon, Generic[T]):
                 Callable[[DbusInterfaceBaseAsync, T],
                          None]],
             flags: int,
+            native: bool = False,
 
     ) -> None:
         assert isinstance(property_getter, FunctionType)
@@ -68,6 +87,7 @@ class DbusPropertyAsync(DbusSomethingAsync, DbusPropertyCommon, Generic[T]):
             Callable[[DbusInterfaceBaseAsync, T],
                      None]] = property_setter
         self.property_setter_is_public: bool = True
+        self.native = native
 
         self.__doc__ = property_getter.__doc__
 
@@ -93,6 +113,10 @@ class DbusPropertyAsync(DbusSomethingAsync, DbusPropertyCommon, Generic[T]):
         assert not iscoroutinefunction(new_set_function), (
             "Property setter can't be coroutine",
         )
+        assert not self.native, (
+            "Native property can't be set from D-Bus. "
+            "Use setter_private instead."
+        )
         self.property_setter = new_set_function
 
     def setter_private(
@@ -119,6 +143,9 @@ class DbusPropertyAsyncBaseBind(DbusBindedAsync, Awaitable[T]):
     async def set_async(self, complete_object: T) -> None:
         raise NotImplementedError
 
+    def set_native(self, new_value: T) -> None:
+        raise NotImplementedError
+
 
 class DbusPropertyAsyncProxyBind(DbusPropertyAsyncBaseBind[T]):
     def __init__(
@@ -181,6 +208,10 @@ class DbusPropertyAsyncLocalBind(DbusPropertyAsyncBaseBind[T]):
         return self.dbus_property.property_getter(local_object)
 
     async def set_async(self, complete_object: T) -> None:
+        if self.dbus_property.native:
+            self.set_native(complete_object)
+            return
+
         if self.dbus_property.property_setter is None:
             raise RuntimeError("Property has no setter")
 
@@ -193,26 +224,86 @@ class DbusPropertyAsyncLocalBind(DbusPropertyAsyncBaseBind[T]):
             complete_object,
         )
 
+        self._queue_properties_changed(local_object, complete_object)
+
+    def set_native(self, new_value: T) -> None:
+        if not self.dbus_property.native:
+            raise RuntimeError("Property is not native")
+
+        local_object = self.local_object_ref()
+        if local_object is None:
+            raise RuntimeError("Local object no longer exists!")
+
+        assert self.dbus_property.property_setter is not None
+        self.dbus_property.property_setter(local_object, new_value)
+
+        local_object_meta = local_object._dbus
+        assert isinstance(local_object_meta, DbusLocalObjectMeta)
+
+        property_name = self.dbus_property.property_name
+        for interface in chain(
+            local_object_meta.activated_interfaces,
+            *local_object_meta.peer_buses_interfaces.values(),
+        ):
+            if property_name in interface.native_property_dict:
+                interface.set_native_property(property_name, new_value)
+
+        self._queue_properties_changed(local_object, new_value)
+
+    def _queue_properties_changed(
+        self,
+        local_object: DbusInterfaceBaseAsync,
+        new_value: Any,
+    ) -> None:
         try:
             properties_changed = getattr(
                 local_object,
                 "properties_changed",
             )
         except AttributeError:
-            ...
-        else:
-            properties_changed.emit(
-                (
-                    self.dbus_property.interface_name,
-                    {
-                        self.dbus_property.property_name: (
-                            self.dbus_property.property_signature,
-                            complete_object,
-                        ),
-                    },
-                    []
-                )
-            )
+            return
+
+        local_object_meta = local_object._dbus
+        assert isinstance(local_object_meta, DbusLocalObjectMeta)
+        properties_changes = local_object_meta.properties_changes
+
+        dbus_property = self.dbus_property
+        if not properties_changes.add(
+            dbus_property.interface_name,
+            dbus_property.property_name,
+            dbus_property.property_signature,
+            new_value,
+            bool(dbus_property.flags & DbusPropertyEmitsInvalidationFlag),
+        ):
+            return
+
+        # Changes made during this loop iteration are emitted together
+        try:
+            loop = get_running_loop()
+        except RuntimeError:
+            self._emit_properties_changes(
+                properties_changed, properties_changes)
+            return
+
+        if properties_changes.is_emit_scheduled(loop):
+            return
+
+        properties_changes.set_emit_handle(
+            loop.call_soon(
+                self._emit_properties_changes,
+                properties_changed,
+                properties_changes,
+            ),
+            loop,
+        )
+
+    @staticmethod
+    def _emit_properties_changes(
+        properties_changed: Any,
+        properties_changes: DbusLocalPropertiesChanges,
+    ) -> None:
+        for signal_data in properties_changes.pop_signals():
+            properties_changed.emit(signal_data)
 
     def _dbus_reply_get(self, message: SdBusMessage) -> None:
         local_object = self.local_object_ref()
@@ -232,26 +323,34 @@ class DbusPropertyAsyncLocalBind(DbusPropertyAsyncBaseBind[T]):
 
         self.dbus_property.property_setter(local_object, data_to_set_to)
 
-        try:
-            properties_changed = getattr(
-                local_object,
-                "properties_changed",
-            )
-        except AttributeError:
-            ...
-        else:
-            properties_changed.emit(
-                (
-                    self.dbus_property.interface_name,
-                    {
-                        self.dbus_property.property_name: (
-                            self.dbus_property.property_signature,
-                            data_to_set_to,
-                        ),
-                    },
-                    []
-                )
-            )
+        self._queue_properties_changed(local_object, data_to_set_to)
+
+
+class DbusPropertiesSnapshotAsync:
+    # Answers GetAll of an exported interface with a single Python call
+    def __init__(self, local_object: DbusInterfaceBaseAsync):
+        self.local_object_ref = weak_ref(local_object)
+        self.property_getters: List[
+            Tuple[str, Callable[[DbusInterfaceBaseAsync], Any]]] = []
+
+    def add_property(self, dbus_property: DbusPropertyAsync[Any]) -> None:
+        # Same properties sd-bus leaves out of GetAll
+        if dbus_property.flags & (DbusHiddenFlag | DbusPropertyExplicitFlag):
+            return
+
+        self.property_getters.append(
+            (dbus_property.property_name, dbus_property.property_getter)
+        )
+
+    def __call__(self) -> Dict[str, Any]:
+        local_object = self.local_object_ref()
+        if local_object is None:
+            raise RuntimeError("Local object no longer exists!")
+
+        return {
+            property_name: property_getter(local_object)
+            for property_name, property_getter in self.property_getters
+        }
 
 
 class DbusPropertyAsyncClassBind(DbusPropertyAsyncBaseBind[T]):
@@ -265,6 +364,7 @@ def dbus_property_async(
         property_signature: str = "",
         flags: int = 0,
         property_name: Optional[str] = None,
+        native: bool = False,
 ) -> Callable[
     [Callable[[Any], T]],
         DbusPropertyAsync[T]]:
@@ -274,6 +374,11 @@ def dbus_property_async(
         "Did you forget () round brackets?"
     )
 
+    assert not native or (
+        len(property_signature) == 1
+        and property_signature in 'ybnqiuxtdsog'
+    ), "Native property must have a single basic type signature"
+
     def property_decorator(
         function: Callable[..., Any]
     ) -> DbusPropertyAsync[T]:
@@ -288,6 +393,7 @@ def dbus_property_async(
             function,
             None,
             flags,
+            native,
         )
 
         return new_wrapper
@@ -214,15 +214,26 @@ class DbusSignalAsyncLocalBind(DbusSignalAsyncBaseBind[T]):
         yield
 
     def _emit_dbus_signal(self, args: T) -> None:
-        attached_bus = self.local_meta.attached_bus
-        if attached_bus is None:
-            return
-
         serving_object_path = self.local_meta.serving_object_path
         if serving_object_path is None:
             return
 
-        signal_message = attached_bus.new_signal_message(
+        attached_bus = self.local_meta.attached_bus
+        if attached_bus is not None:
+            self._emit_dbus_signal_on_bus(
+                attached_bus, serving_object_path, args)
+
+        for peer_bus in self.local_meta.peer_buses_interfaces:
+            self._emit_dbus_signal_on_bus(
+                peer_bus, serving_object_path, args)
+
+    def _emit_dbus_signal_on_bus(
+        self,
+        bus: SdBus,
+        serving_object_path: str,
+        args: T,
+    ) -> None:
+        signal_message = bus.new_signal_message(
             serving_object_path,
             self.dbus_signal.interface_name,
             self.dbus_signal.signal_name,
@@ -69,24 +69,24 @@ class DbusPropertiesInterface(
             on_unknown_member: Literal['error', 'ignore', 'reuse'] = 'error',
     ) -> Dict[str, Any]:
         properties: Dict[str, Any] = {}
+        bus = self._dbus.attached_bus
 
         for interface_name in self._dbus_meta.dbus_interfaces_names:
-            dbus_properties_data = self._properties_get_all(interface_name)
-            for member_name, variant in dbus_properties_data.items():
-                try:
-                    python_name = self._dbus_meta.dbus_member_to_python_attr[
-                        member_name]
-                except KeyError:
-                    if on_unknown_member == 'error':
-                        raise
-                    elif on_unknown_member == 'ignore':
-                        continue
-                    elif on_unknown_member == 'reuse':
-                        python_name = member_name
-                    else:
-                        raise ValueError
-
-                properties[python_name] = variant[1]
+            get_all_message = bus.new_method_call_message(
+                self._dbus.service_name,
+                self._dbus.object_path,
+                'org.freedesktop.DBus.Properties',
+                'GetAll',
+            )
+            get_all_message.append_data('s', interface_name)
+            reply_message = bus.call(get_all_message)
+
+            properties.update(
+                reply_message.read_properties_dict(
+                    name_map=self._dbus_meta.dbus_member_to_python_attr,
+                    on_unknown_member=on_unknown_member,
+                )
+            )
 
         return properties
 
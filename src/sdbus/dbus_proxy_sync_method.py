@@ -68,7 +68,9 @@ class DbusMethodSyncBinded(DbusBindedSync):
                 self.dbus_method.input_signature, *args)
 
         reply_message = self.interface._dbus.attached_bus.call(
-            new_call_message)
+            new_call_message,
+            timeout_usec=self.dbus_method.timeout_usec,
+        )
         return reply_message.get_contents()
 
     def __call__(self, *args: Any, **kwargs: Any) -> Any:
@@ -91,6 +93,7 @@ def dbus_method(
     result_signature: str = "",
     flags: int = 0,
     method_name: Optional[str] = None,
+    timeout_usec: int = 0,
 ) -> Callable[[T], T]:
     assert not isinstance(input_signature, FunctionType), (
         "Passed function to decorator directly. "
@@ -111,6 +114,7 @@ def dbus_method(
             result_args_names=(),
             input_args_names=(),
             flags=flags,
+            timeout_usec=timeout_usec,
         )
 
         return cast(T, new_wrapper)
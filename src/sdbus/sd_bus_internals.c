@@ -22,17 +22,24 @@
 
 // Python functions and objects
 PyObject* asyncio_get_running_loop = NULL;
+PyObject* asyncio_gather = NULL;
+PyObject* asyncio_cancelled_error = NULL;
+PyObject* asyncio_invalid_state_error = NULL;
 PyObject* is_coroutine_function = NULL;
+PyObject* asyncio_eager_task_class = NULL;
 // Str objects
 PyObject* set_result_str = NULL;
 PyObject* set_exception_str = NULL;
 PyObject* add_reader_str = NULL;
 PyObject* remove_reader_str = NULL;
+PyObject* add_writer_str = NULL;
+PyObject* remove_writer_str = NULL;
 PyObject* empty_str = NULL;
 PyObject* null_str = NULL;
 PyObject* extend_str = NULL;
 PyObject* append_str = NULL;
 PyObject* call_soon_str = NULL;
+PyObject* call_later_str = NULL;
 PyObject* create_task_str = NULL;
 // Exceptions
 PyObject* exception_base = NULL;
@@ -46,15 +53,31 @@ PyObject* exception_request_name_already_owner = NULL;  // Already an owner of t
 PyObject* dbus_error_to_exception_dict = NULL;
 PyObject* exception_to_dbus_error_dict = NULL;
 
+PyObject* signature_plans_dict = NULL;
+
+PyObject* string_caches_dict = NULL;  // Bus pointer to string cache capsule
+
+PyObject* bus_objects_dict = NULL;  // Bus pointer to SdBus object pointer of async or corked buses
+
+PyObject* struct_types_dict = NULL;  // Struct contents signature to constructor
+
 // SdBusSlot
 
+static void _wait_slot_bus(sd_bus_slot* slot) {
+        if (slot != NULL) {
+                _SdBus_wait_blocking_call(sd_bus_slot_get_bus(slot));
+        }
+}
+
 static void SdBusSlot_dealloc(SdBusSlotObject* self) {
+        _wait_slot_bus(self->slot_ref);
         sd_bus_slot_unref(self->slot_ref);
 
         SD_BUS_DEALLOC_TAIL;
 }
 
 static PyObject* SdBusSlot_close(SdBusSlotObject* self) {
+        _wait_slot_bus(self->slot_ref);
         sd_bus_slot_unref(self->slot_ref);
         self->slot_ref = NULL;
 
@@ -88,6 +111,10 @@ PyObject* SdBus_class = NULL;
 PyObject* SdBusMessage_class = NULL;
 PyObject* SdBusSlot_class = NULL;
 PyObject* SdBusInterface_class = NULL;
+PyObject* SdBusPendingCall_class = NULL;
+#ifdef SD_BUS_PY_BUFFER_EXPORT
+PyObject* SdBusMessageBuffer_class = NULL;
+#endif
 
 #define SD_BUS_PY_INIT_TYPE_READY(type_slots)                                  \
         ({                                                                     \
@@ -119,6 +146,14 @@ PyMODINIT_FUNC PyInit_sd_bus_internals(void) {
         SdBusInterface_class = SD_BUS_PY_INIT_TYPE_READY(SdBusInterfaceType);
         SD_BUS_PY_INIT_ADD_OBJECT("SdBusInterface", SdBusInterface_class);
 
+        SdBusPendingCall_class = SD_BUS_PY_INIT_TYPE_READY(SdBusPendingCallType);
+        SD_BUS_PY_INIT_ADD_OBJECT("SdBusPendingCall", SdBusPendingCall_class);
+
+#ifdef SD_BUS_PY_BUFFER_EXPORT
+        // Internal type not exposed in module
+        SdBusMessageBuffer_class = SD_BUS_PY_INIT_TYPE_READY(SdBusMessageBufferType);
+#endif
+
         // Exception map
         dbus_error_to_exception_dict = CALL_PYTHON_AND_CHECK(PyDict_New());
         SD_BUS_PY_INIT_ADD_OBJECT("DBUS_ERROR_TO_EXCEPTION", dbus_error_to_exception_dict);
@@ -126,6 +161,11 @@ PyMODINIT_FUNC PyInit_sd_bus_internals(void) {
         exception_to_dbus_error_dict = CALL_PYTHON_AND_CHECK(PyDict_New());
         SD_BUS_PY_INIT_ADD_OBJECT("EXCEPTION_TO_DBUS_ERROR", exception_to_dbus_error_dict);
 
+        signature_plans_dict = CALL_PYTHON_AND_CHECK(PyDict_New());
+        string_caches_dict = CALL_PYTHON_AND_CHECK(PyDict_New());
+        bus_objects_dict = CALL_PYTHON_AND_CHECK(PyDict_New());
+        struct_types_dict = CALL_PYTHON_AND_CHECK(PyDict_New());
+
         PyObject* new_base_exception CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyErr_NewException("sd_bus_internals.SdBusBaseError", NULL, NULL));
         SD_BUS_PY_INIT_ADD_OBJECT("SdBusBaseError", new_base_exception);
         exception_base = new_base_exception;
@@ -164,13 +204,23 @@ PyMODINIT_FUNC PyInit_sd_bus_internals(void) {
         PyObject* asyncio_module = CALL_PYTHON_AND_CHECK(PyImport_ImportModule("asyncio"));
 
         asyncio_get_running_loop = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString(asyncio_module, "get_running_loop"));
+        asyncio_gather = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString(asyncio_module, "gather"));
+        asyncio_cancelled_error = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString(asyncio_module, "CancelledError"));
+        asyncio_invalid_state_error = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString(asyncio_module, "InvalidStateError"));
+        // Task eager_start was added together with eager_task_factory
+        if (PyObject_HasAttrString(asyncio_module, "eager_task_factory")) {
+                asyncio_eager_task_class = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString(asyncio_module, "Task"));
+        }
 
         set_result_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("set_result"));
         set_exception_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("set_exception"));
         call_soon_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("call_soon"));
+        call_later_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("call_later"));
         create_task_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("create_task"));
         remove_reader_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("remove_reader"));
         add_reader_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("add_reader"));
+        add_writer_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("add_writer"));
+        remove_writer_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("remove_writer"));
         empty_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString(""));
         null_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromStringAndSize("\0", 1));
         extend_str = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("extend"));
@@ -179,6 +229,7 @@ PyMODINIT_FUNC PyInit_sd_bus_internals(void) {
         PyObject* inspect_module = CALL_PYTHON_AND_CHECK(PyImport_ImportModule("inspect"));
         is_coroutine_function = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString(inspect_module, "iscoroutinefunction"));
 
+
         CALL_PYTHON_INT_CHECK(PyModule_AddIntConstant(m, "DbusDeprecatedFlag", SD_BUS_VTABLE_DEPRECATED));
         CALL_PYTHON_INT_CHECK(PyModule_AddIntConstant(m, "DbusHiddenFlag", SD_BUS_VTABLE_HIDDEN));
         CALL_PYTHON_INT_CHECK(PyModule_AddIntConstant(m, "DbusUnprivilegedFlag", SD_BUS_VTABLE_UNPRIVILEGED));
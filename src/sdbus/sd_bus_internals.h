@@ -232,6 +232,12 @@
 #define SD_BUS_PY_TUPLE_SET_ITEM PyTuple_SetItem
 #endif
 
+#ifndef Py_LIMITED_API
+#define SD_BUS_PY_LIST_SET_ITEM PyList_SET_ITEM
+#else
+#define SD_BUS_PY_LIST_SET_ITEM PyList_SetItem
+#endif
+
 #ifndef Py_LIMITED_API
 #define SD_BUS_PY_LIST_GET_SIZE PyList_GET_SIZE
 #else
@@ -240,17 +246,24 @@
 
 // Python functions and objects
 extern PyObject* asyncio_get_running_loop;
+extern PyObject* asyncio_gather;
+extern PyObject* asyncio_cancelled_error;
+extern PyObject* asyncio_invalid_state_error;
 extern PyObject* is_coroutine_function;
+extern PyObject* asyncio_eager_task_class;  // asyncio.Task if it accepts eager_start, otherwise NULL
 // Str objects
 extern PyObject* set_result_str;
 extern PyObject* set_exception_str;
 extern PyObject* add_reader_str;
 extern PyObject* remove_reader_str;
+extern PyObject* add_writer_str;
+extern PyObject* remove_writer_str;
 extern PyObject* empty_str;
 extern PyObject* null_str;
 extern PyObject* extend_str;
 extern PyObject* append_str;
 extern PyObject* call_soon_str;
+extern PyObject* call_later_str;
 extern PyObject* create_task_str;
 // Exceptions
 extern PyObject* exception_base;
@@ -264,6 +277,14 @@ extern PyObject* exception_request_name_already_owner;  // Already an owner of t
 extern PyObject* dbus_error_to_exception_dict;
 extern PyObject* exception_to_dbus_error_dict;
 
+extern PyObject* signature_plans_dict;
+
+extern PyObject* string_caches_dict;
+
+extern PyObject* bus_objects_dict;
+
+extern PyObject* struct_types_dict;
+
 __attribute__((used)) static inline void _cleanup_char_ptr(const char** ptr) {
         if (*ptr != NULL) {
                 free((char*)*ptr);
@@ -278,6 +299,16 @@ __attribute__((used)) static inline void PyObject_cleanup(PyObject** object) {
 
 #define CLEANUP_PY_OBJECT __attribute__((cleanup(PyObject_cleanup)))
 
+#ifndef Py_LIMITED_API
+__attribute__((used)) static inline void _cleanup_py_buffer(Py_buffer* buffer) {
+        if (buffer->obj != NULL) {
+                PyBuffer_Release(buffer);
+        }
+}
+
+#define CLEANUP_PY_BUFFER __attribute__((cleanup(_cleanup_py_buffer)))
+#endif
+
 // SdBusSlot
 typedef struct {
         PyObject_HEAD;
@@ -294,6 +325,30 @@ extern PyType_Spec SdBusSlotType;
 extern PyObject* SdBusSlot_class;
 
 // SdBusInterface
+typedef union {
+        // Layout sd-bus expects for properties without getter
+        uint8_t y;
+        int b;
+        int16_t n;
+        uint16_t q;
+        int32_t i;
+        uint32_t u;
+        int64_t x;
+        uint64_t t;
+        double d;
+        char* s;  // Also 'o' and 'g'
+} SdBusNativeValue;
+
+typedef struct {
+        PyObject* callback;  // Method callback or property getter
+        PyObject* setter;    // Property setter or NULL
+        int is_coroutine;
+        char native_type;  // Type of native property or '\0'
+        SdBusNativeValue native_value;
+        PyObject* property_name;   // Property name or NULL for methods
+        PyObject* signature_plan;  // Property signature plan or NULL
+} SdBusInterfaceMember;
+
 typedef struct {
         PyObject_HEAD;
         SdBusSlotObject* interface_slot;
@@ -302,12 +357,61 @@ typedef struct {
         PyObject* property_list;
         PyObject* property_get_dict;
         PyObject* property_set_dict;
+        PyObject* native_property_dict;
         PyObject* signal_list;
+        PyObject* properties_snapshot;  // Callable returning all properties or NULL
+        SdBusSlotObject* snapshot_slot;
+        char* interface_name;  // Set when snapshot handler is added
         sd_bus_vtable* vtable;
+        SdBusInterfaceMember* members;
+        Py_ssize_t members_count;
 } SdBusInterfaceObject;
 
 extern PyType_Spec SdBusInterfaceType;
 extern PyObject* SdBusInterface_class;
+extern int _SdBusInterface_add_snapshot_handler(SdBusInterfaceObject* self, sd_bus* bus, const char* path, const char* interface_name);
+
+// Signature plans
+typedef struct {
+        char type;  // Structs are 'r' and dict entries are 'e'
+        size_t size;  // Number of nodes this complete type spans
+        size_t members_count;
+        const char* contents;  // NULL for basic types and variants
+        size_t contents_length;
+} SdBusSignatureNode;
+
+typedef struct {
+        const char* signature;
+        size_t complete_types_count;
+        size_t nodes_count;
+        SdBusSignatureNode nodes[];
+} SdBusSignaturePlan;
+
+extern PyObject* _SdBusSignature_get_plan(PyObject* signature_str);
+extern const SdBusSignaturePlan* _SdBusSignature_plan_from_capsule(PyObject* plan_capsule);
+
+// String cache
+#define SD_BUS_STRING_CACHE_DEFAULT_SIZE 256
+#define SD_BUS_STRING_CACHE_MAX_LENGTH 63
+
+typedef struct {
+        PyObject* string;
+        size_t length;
+        char key[SD_BUS_STRING_CACHE_MAX_LENGTH + 1];
+} SdBusStringCacheEntry;
+
+typedef struct {
+        unsigned long long hits;
+        unsigned long long misses;
+        size_t entries_count;
+        SdBusStringCacheEntry entries[];
+} SdBusStringCache;
+
+extern PyObject* _SdBusStringCache_capsule_for_bus(sd_bus* bus, int create);
+extern SdBusStringCache* _SdBusStringCache_from_capsule(PyObject* cache_capsule);
+extern int _SdBusStringCache_resize(sd_bus* bus, size_t new_size);
+extern void _SdBusStringCache_remove(sd_bus* bus);
+extern PyObject* _SdBusStringCache_get_string(SdBusStringCache* cache, const char* string);
 
 // SdBusMessage
 typedef struct {
@@ -320,21 +424,91 @@ __attribute__((used)) static inline void cleanup_SdBusMessage(SdBusMessageObject
 }
 
 extern void _SdBusMessage_set_messsage(SdBusMessageObject* self, sd_bus_message* new_message);
+extern PyObject* _SdBusMessage_append_complete(sd_bus_message* message, const SdBusSignatureNode* node, PyObject* complete_obj);
 
 #define CLEANUP_SD_BUS_MESSAGE __attribute__((cleanup(cleanup_SdBusMessage)))
 
 extern PyType_Spec SdBusMessageType;
 extern PyObject* SdBusMessage_class;
 
+// SdBusMessageBuffer
+// Buffer slots in type specs require Python 3.9 or limited API 3.11
+#if !defined(Py_LIMITED_API) && PY_VERSION_HEX >= 0x03090000
+#define SD_BUS_PY_BUFFER_EXPORT
+#endif
+
+#ifdef SD_BUS_PY_BUFFER_EXPORT
+typedef struct {
+        PyObject_HEAD;
+        SdBusMessageObject* message_object;
+        const void* buffer_ptr;
+        Py_ssize_t buffer_size;
+        Py_ssize_t item_size;
+        Py_ssize_t items_count;
+        const char* format;
+} SdBusMessageBufferObject;
+
+extern PyType_Spec SdBusMessageBufferType;
+extern PyObject* SdBusMessageBuffer_class;
+#endif
+
+// SdBusPendingCall
+typedef struct {
+        PyObject_HEAD;
+        sd_bus_slot* slot_ref;
+        PyObject* bus;  // SdBus that keeps the call counters
+        PyObject* loop;
+        PyObject* result;  // Reply message
+        PyObject* exception;
+        PyObject* callbacks;  // List of (callback, context) tuples
+        PyObject* cancel_message;
+        int state;
+        int blocking;
+        int log_exception;  // Exception was not retrieved yet
+} SdBusPendingCallObject;
+
+__attribute__((used)) static inline void cleanup_SdBusPendingCall(SdBusPendingCallObject** object) {
+        Py_XDECREF(*object);
+}
+
+#define CLEANUP_SD_BUS_PENDING_CALL __attribute__((cleanup(cleanup_SdBusPendingCall)))
+
+extern PyType_Spec SdBusPendingCallType;
+extern PyObject* SdBusPendingCall_class;
+
+extern PyObject* _SdBusPendingCall_new(PyObject* bus, PyObject* loop);
+extern int _SdBusPendingCall_callback(sd_bus_message* m, void* userdata, sd_bus_error* ret_error);
+
 // SdBus
 typedef struct {
         PyObject_HEAD;
         sd_bus* sd_bus_ref;
         PyObject* reader_fd;
+        int writer_registered;  // Loop writer is registered while sd-bus has queued output
+        PyThread_type_lock blocking_call_lock;  // Held during blocking calls with the GIL released
+        unsigned long long drive_budget;  // Messages dispatched per drive, 0 is unlimited
+        unsigned long long drive_time_budget_usec;  // Time spent per drive, 0 is unlimited
+        int drive_prioritize_replies;
+        PyObject* drive_handle;  // Pending call_soon handle of a rescheduled drive
+        PyObject* deferred_signals;  // List of (callback, message) tuples waiting for dispatch
+        PyObject* timer_handle;  // call_later handle driving the bus at the next sd-bus timeout
+        uint64_t timer_deadline_usec;
+        unsigned long long pending_calls_count;  // Async calls holding a reply slot
+        unsigned long long cancelled_calls_count;  // Async calls whose slot was released by cancel
+        int cork_sends;  // Cork sends until the end of loop iteration
+        unsigned int cork_depth;  // Nesting of explicit cork calls
+        PyObject* corked_messages;  // List of messages waiting for flush
+        PyObject* cork_handle;  // Pending call_soon handle of flush
+        int eager_dispatch;  // Run coroutine method handlers inline until they suspend
 } SdBusObject;
 
 extern PyType_Spec SdBusType;
 extern PyObject* SdBus_class;
+extern SdBusObject* driving_bus;
+
+extern void _SdBus_wait_blocking_call(sd_bus* bus);
+extern PyObject* _SdBus_send_message(SdBusMessageObject* message);
+extern PyObject* _SdBus_exception_from_message(sd_bus_message* message);
 
 // Module level functions
 extern PyMethodDef SdBusPyInternal_methods[];
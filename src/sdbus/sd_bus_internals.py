@@ -28,7 +28,9 @@ if TYPE_CHECKING:
         Callable,
         Coroutine,
         Dict,
+        Iterable,
         List,
+        Literal,
         Optional,
         Sequence,
         Tuple,
@@ -64,6 +66,7 @@ class SdBusInterface:
     property_list: List[object]
     property_get_dict: Dict[bytes, object]
     property_set_dict: Dict[bytes, object]
+    native_property_dict: Dict[str, Optional[int]]
     signal_list: List[object]
 
     def add_method(
@@ -72,7 +75,8 @@ class SdBusInterface:
         signature: str, input_args_names: Sequence[str],
         result_signature: str, result_args_names: Sequence[str],
         flags: int,
-        callback: Callable[[SdBusMessage], Coroutine[Any, Any, None]], /
+        callback: Callable[
+            [SdBusMessage], Optional[Coroutine[Any, Any, None]]], /
     ) -> None:
         raise NotImplementedError(__STUB_ERROR)
 
@@ -86,6 +90,28 @@ class SdBusInterface:
     ) -> None:
         raise NotImplementedError(__STUB_ERROR)
 
+    def add_native_property(
+        self,
+        property_name: str,
+        property_signature: str,
+        initial_value: DbusBasicTypes,
+        flags: int, /
+    ) -> None:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def set_native_property(
+        self,
+        property_name: str,
+        new_value: DbusBasicTypes, /
+    ) -> None:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def set_properties_snapshot(
+        self,
+        snapshot_function: Optional[Callable[[], Dict[str, Any]]], /
+    ) -> None:
+        raise NotImplementedError(__STUB_ERROR)
+
     def add_signal(
         self,
         signal_name: str,
@@ -120,8 +146,37 @@ class SdBusMessage:
     def seal(self) -> None:
         raise NotImplementedError(__STUB_ERROR)
 
-    def get_contents(self
-                     ) -> Tuple[DbusCompleteTypes, ...]:
+    def get_contents(
+            self, *,
+            arrays: Literal['list', 'buffer'] = 'list',
+            byte_arrays: Literal['bytes', 'memoryview'] = 'bytes',
+    ) -> Tuple[DbusCompleteTypes, ...]:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def read_data(
+            self, signature: str, /, *,
+            arrays: Literal['list', 'buffer'] = 'list',
+            byte_arrays: Literal['bytes', 'memoryview'] = 'bytes',
+    ) -> Any:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def read_properties_dict(
+            self, *,
+            name_map: Optional[Dict[str, str]] = None,
+            on_unknown_member: Literal['error', 'ignore', 'reuse'] = 'error',
+    ) -> Dict[str, Any]:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def skip(self, signature: str, /) -> None:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def peek_type(self) -> Optional[Tuple[str, str]]:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def at_end(self) -> bool:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def rewind(self) -> None:
         raise NotImplementedError(__STUB_ERROR)
 
     def create_reply(self) -> SdBusMessage:
@@ -144,13 +199,42 @@ class SdBusMessage:
     sender: Optional[str] = None
 
 
+if TYPE_CHECKING:
+    _SdBusPendingCallBase = Future[SdBusMessage]
+else:
+    _SdBusPendingCallBase = Future
+
+
+class SdBusPendingCall(_SdBusPendingCallBase):
+    """Awaitable reply of SdBus.call_async
+
+    Implements asyncio.Future protocol without being a subclass.
+    """
+
+
 class SdBus:
-    def call(self, message: SdBusMessage, /) -> SdBusMessage:
+    def call(self, message: SdBusMessage, /,
+             *, timeout_usec: int = 0,
+             deadline_usec: int = 0) -> SdBusMessage:
         raise NotImplementedError(__STUB_ERROR)
 
     def call_async(
             self, message: SdBusMessage,
-            /) -> Future[SdBusMessage]:
+            /, *, timeout_usec: int = 0,
+            deadline_usec: int = 0) -> SdBusPendingCall:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def call_many(
+            self, messages: Iterable[SdBusMessage],
+            /, *, timeout_usec: int = 0,
+            deadline_usec: int = 0) -> List[Union[SdBusMessage, Exception]]:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def call_many_async(
+            self, messages: Iterable[SdBusMessage],
+            /, *, timeout_usec: int = 0,
+            deadline_usec: int = 0,
+    ) -> Future[List[Union[SdBusMessage, Exception]]]:
         raise NotImplementedError(__STUB_ERROR)
 
     def drive(self) -> None:
@@ -215,6 +299,15 @@ class SdBus:
     def emit_object_removed(self, path: str, /) -> None:
         raise NotImplementedError(__STUB_ERROR)
 
+    def cork(self) -> None:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def uncork(self) -> None:
+        raise NotImplementedError(__STUB_ERROR)
+
+    def flush_corked(self) -> None:
+        raise NotImplementedError(__STUB_ERROR)
+
     def close(self) -> None:
         raise NotImplementedError(__STUB_ERROR)
 
@@ -223,6 +316,16 @@ class SdBus:
 
     address: Optional[str] = None
     method_call_timeout_usec: int = 0
+    string_cache_hits: int = 0
+    string_cache_misses: int = 0
+    string_cache_size: int = 256
+    pending_calls: int = 0
+    cancelled_calls: int = 0
+    drive_budget: int = 0
+    drive_time_budget_usec: int = 0
+    drive_prioritize_replies: bool = False
+    cork_sends: bool = False
+    eager_dispatch: bool = False
 
 
 def sd_bus_open() -> SdBus:
@@ -249,6 +352,14 @@ def sd_bus_open_system_machine(machine: str, /) -> SdBus:
     raise NotImplementedError(__STUB_ERROR)
 
 
+def sd_bus_open_peer_fd(fd: int, /, *, server: bool = False) -> SdBus:
+    raise NotImplementedError(__STUB_ERROR)
+
+
+def sd_bus_open_peer_address(address: str, /) -> SdBus:
+    raise NotImplementedError(__STUB_ERROR)
+
+
 def encode_object_path(prefix: str, external: str) -> str:
     raise NotImplementedError(__STUB_ERROR)
 
@@ -282,6 +393,16 @@ def is_object_path_valid(string_to_check: str, /) -> bool:
     raise NotImplementedError(__STUB_ERROR)
 
 
+def register_struct_type(
+        signature: str,
+        struct_type: Callable[..., Any], /) -> None:
+    raise NotImplementedError(__STUB_ERROR)
+
+
+def unregister_struct_type(signature: str, /) -> None:
+    raise NotImplementedError(__STUB_ERROR)
+
+
 class SdBusBaseError(Exception):
     ...
 
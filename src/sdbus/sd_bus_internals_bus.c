@@ -21,9 +21,117 @@
 #include <errno.h>
 #include "sd_bus_internals.h"
 
+#include <poll.h>
+#include <time.h>
+
+// Blocking calls
+//
+// Blocking sd-bus calls release the GIL for the whole round-trip.
+// sd-bus is not thread safe so while a blocking call is in progress
+// every other use of the same bus waits for it to finish. Blocking
+// calls in progress are kept in a list that is only accessed with
+// the GIL held. Messages and slots only know their sd_bus so the
+// list is searched by sd_bus pointer.
+
+typedef struct _BlockingCall {
+        sd_bus* bus;
+        SdBusObject* bus_object;
+        struct _BlockingCall* next;
+} _BlockingCall;
+
+static _BlockingCall* blocking_calls = NULL;
+
+static _BlockingCall* _find_blocking_call(sd_bus* bus) {
+        for (_BlockingCall* blocking_call = blocking_calls; blocking_call != NULL; blocking_call = blocking_call->next) {
+                if (blocking_call->bus == bus) {
+                        return blocking_call;
+                }
+        }
+        return NULL;
+}
+
+void _SdBus_wait_blocking_call(sd_bus* bus) {
+        if (blocking_calls == NULL || bus == NULL) {
+                return;
+        }
+
+        _BlockingCall* blocking_call = NULL;
+        while ((blocking_call = _find_blocking_call(bus)) != NULL) {
+                SdBusObject* bus_object = blocking_call->bus_object;
+                Py_INCREF(bus_object);
+                Py_BEGIN_ALLOW_THREADS;
+                PyThread_acquire_lock(bus_object->blocking_call_lock, WAIT_LOCK);
+                PyThread_release_lock(bus_object->blocking_call_lock);
+                Py_END_ALLOW_THREADS;
+                Py_DECREF(bus_object);
+        }
+}
+
+static _BlockingCall* _SdBus_begin_blocking_call(SdBusObject* self) {
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
+
+        if (self->blocking_call_lock == NULL) {
+                self->blocking_call_lock = PyThread_allocate_lock();
+                if (self->blocking_call_lock == NULL) {
+                        return (_BlockingCall*)PyErr_NoMemory();
+                }
+        }
+        _BlockingCall* blocking_call = PyMem_Malloc(sizeof(_BlockingCall));
+        if (blocking_call == NULL) {
+                return (_BlockingCall*)PyErr_NoMemory();
+        }
+
+        // Other threads only hold the lock while waiting with the GIL released
+        PyThread_acquire_lock(self->blocking_call_lock, WAIT_LOCK);
+        blocking_call->bus = self->sd_bus_ref;
+        blocking_call->bus_object = self;
+        blocking_call->next = blocking_calls;
+        blocking_calls = blocking_call;
+        return blocking_call;
+}
+
+static void _SdBus_end_blocking_call(SdBusObject* self, _BlockingCall* blocking_call) {
+        for (_BlockingCall** list_ptr = &blocking_calls; *list_ptr != NULL; list_ptr = &(*list_ptr)->next) {
+                if (*list_ptr == blocking_call) {
+                        *list_ptr = blocking_call->next;
+                        break;
+                }
+        }
+        PyThread_release_lock(self->blocking_call_lock);
+        PyMem_Free(blocking_call);
+}
+
+static void _SdBus_remove_bus_object(sd_bus* bus) {
+        // Called from dealloc which must not change the current exception
+        PyObject *error_type, *error_value, *error_traceback;
+        PyErr_Fetch(&error_type, &error_value, &error_traceback);
+
+        PyObject* bus_key CLEANUP_PY_OBJECT = PyLong_FromVoidPtr(bus);
+        if (bus_key == NULL || PyDict_DelItem(bus_objects_dict, bus_key) < 0) {
+                // Bus was never used with asyncio or corked
+                PyErr_Clear();
+        }
+
+        PyErr_Restore(error_type, error_value, error_traceback);
+}
+
 static void SdBus_dealloc(SdBusObject* self) {
+        if (self->sd_bus_ref != NULL) {
+                _SdBusStringCache_remove(self->sd_bus_ref);
+        }
+        if (self->sd_bus_ref != NULL) {
+                _SdBus_remove_bus_object(self->sd_bus_ref);
+        }
         sd_bus_unref(self->sd_bus_ref);
         Py_XDECREF(self->reader_fd);
+        Py_XDECREF(self->deferred_signals);
+        Py_XDECREF(self->drive_handle);
+        Py_XDECREF(self->timer_handle);
+        Py_XDECREF(self->corked_messages);
+        Py_XDECREF(self->cork_handle);
+        if (self->blocking_call_lock != NULL) {
+                PyThread_free_lock(self->blocking_call_lock);
+        }
 
         SD_BUS_DEALLOC_TAIL;
 }
@@ -53,6 +161,7 @@ static SdBusMessageObject* SdBus_new_method_call_message(SdBusObject* self, PyOb
         const char* member_name = NULL;
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "ssss", &destination_bus_name, &object_path, &interface_name, &member_name, NULL));
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         SdBusMessageObject* new_message_object CLEANUP_SD_BUS_MESSAGE =
             (SdBusMessageObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
 
@@ -83,6 +192,7 @@ static SdBusMessageObject* SdBus_new_property_get_message(SdBusObject* self, PyO
         const char* property_name = NULL;
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "ssss", &destination_service_name, &object_path, &interface_name, &property_name, NULL));
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         SdBusMessageObject* new_message_object CLEANUP_SD_BUS_MESSAGE =
             (SdBusMessageObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
         CALL_SD_BUS_AND_CHECK(sd_bus_message_new_method_call(self->sd_bus_ref, &new_message_object->message_ref, destination_service_name, object_path,
@@ -116,6 +226,7 @@ static SdBusMessageObject* SdBus_new_property_set_message(SdBusObject* self, PyO
         const char* property_name = NULL;
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "ssss", &destination_service_name, &object_path, &interface_name, &property_name, NULL));
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         SdBusMessageObject* new_message_object CLEANUP_SD_BUS_MESSAGE =
             (SdBusMessageObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
         CALL_SD_BUS_AND_CHECK(sd_bus_message_new_method_call(self->sd_bus_ref, &new_message_object->message_ref, destination_service_name, object_path,
@@ -146,6 +257,7 @@ static SdBusMessageObject* SdBus_new_signal_message(SdBusObject* self, PyObject*
         const char* member_name = NULL;
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "sss", &object_path, &interface_name, &member_name, NULL));
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         SdBusMessageObject* new_message_object CLEANUP_SD_BUS_MESSAGE =
             (SdBusMessageObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
 
@@ -155,28 +267,56 @@ static SdBusMessageObject* SdBus_new_signal_message(SdBusObject* self, PyObject*
         return new_message_object;
 }
 
-#ifndef Py_LIMITED_API
-static int _check_sdbus_message(PyObject* something) {
-        return PyType_IsSubtype(Py_TYPE(something), (PyTypeObject*)SdBusMessage_class);
+static PyObject* _SdBus_send_corked(SdBusObject* self);
+
+static uint64_t _monotonic_usec(void) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
 }
 
-static SdBusMessageObject* SdBus_call(SdBusObject* self, PyObject* const* args, Py_ssize_t nargs) {
-        // TODO: Check reference counting
-        SD_BUS_PY_CHECK_ARGS_NUMBER(1);
-        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(0, _check_sdbus_message);
+// Per call timeout
+//
+// timeout_usec is relative and deadline_usec is absolute CLOCK_MONOTONIC
+// time, same clock as time.monotonic(). Zero means not set. When both
+// are set the earlier one wins. Zero result uses bus default timeout.
+static uint64_t _call_timeout_usec(unsigned long long timeout_usec, unsigned long long deadline_usec) {
+        if (deadline_usec == 0) {
+                return (uint64_t)timeout_usec;
+        }
 
-        SdBusMessageObject* call_message = (SdBusMessageObject*)args[0];
-#else
-static SdBusMessageObject* SdBus_call(SdBusObject* self, PyObject* args) {
+        uint64_t now_usec = _monotonic_usec();
+        // Already expired deadline still needs non-zero timeout
+        uint64_t deadline_timeout_usec = deadline_usec > now_usec ? deadline_usec - now_usec : 1;
+        if (timeout_usec != 0 && timeout_usec < deadline_timeout_usec) {
+                return (uint64_t)timeout_usec;
+        }
+        return deadline_timeout_usec;
+}
+
+static SdBusMessageObject* SdBus_call(SdBusObject* self, PyObject* args, PyObject* kwargs) {
+        static char* kwlist[] = {"", "timeout_usec", "deadline_usec", NULL};
         SdBusMessageObject* call_message = NULL;
-        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "O", &call_message, NULL));
-#endif
+        unsigned long long timeout_usec = 0;
+        unsigned long long deadline_usec = 0;
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTupleAndKeywords(args, kwargs, "O!|$KK", kwlist, (PyTypeObject*)SdBusMessage_class, &call_message, &timeout_usec,
+                                                           &deadline_usec));
+        uint64_t call_timeout_usec = _call_timeout_usec(timeout_usec, deadline_usec);
         SdBusMessageObject* reply_message_object CLEANUP_SD_BUS_MESSAGE =
             (SdBusMessageObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
 
         sd_bus_error error __attribute__((cleanup(sd_bus_error_free))) = SD_BUS_ERROR_NULL;
 
-        int return_value = sd_bus_call(self->sd_bus_ref, call_message->message_ref, (uint64_t)0, &error, &reply_message_object->message_ref);
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
+        _BlockingCall* blocking_call = _SdBus_begin_blocking_call(self);
+        if (blocking_call == NULL) {
+                return NULL;
+        }
+        int return_value = 0;
+        Py_BEGIN_ALLOW_THREADS;
+        return_value = sd_bus_call(self->sd_bus_ref, call_message->message_ref, call_timeout_usec, &error, &reply_message_object->message_ref);
+        Py_END_ALLOW_THREADS;
+        _SdBus_end_blocking_call(self, blocking_call);
 
         if (sd_bus_error_get_errno(&error)) {
                 PyObject* error_name_str CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyUnicode_FromString(error.name));
@@ -202,52 +342,85 @@ static SdBusMessageObject* SdBus_call(SdBusObject* self, PyObject* args) {
         return reply_message_object;
 }
 
-int future_set_exception_from_message(PyObject* future, sd_bus_message* message) {
-        const sd_bus_error* callback_error = sd_bus_message_get_error(message);
-
-        PyObject* error_name_str CLEANUP_PY_OBJECT = CALL_PYTHON_CHECK_RETURN_NEG1(PyUnicode_FromString(callback_error->name));
-        PyObject* error_message_str CLEANUP_PY_OBJECT = CALL_PYTHON_CHECK_RETURN_NEG1(PyUnicode_FromString(callback_error->message));
+static PyObject* _SdBus_exception_from_error(const sd_bus_error* callback_error) {
+        PyObject* error_name_str CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyUnicode_FromString(callback_error->name));
+        PyObject* error_message_str CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyUnicode_FromString(callback_error->message));
 
         PyObject* exception_to_raise = PyDict_GetItemWithError(dbus_error_to_exception_dict, error_name_str);
-
-        PyObject* exception_occurred = PyErr_Occurred();
-        if (exception_occurred) {
-                Py_XDECREF(CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallMethodObjArgs(future, set_exception_str, exception_occurred, NULL)));
-                return 0;
-        }
+        PYTHON_ERR_OCCURED;
 
         if (exception_to_raise) {
-                PyObject* new_exception CLEANUP_PY_OBJECT =
-                    CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallFunctionObjArgs(exception_to_raise, error_message_str, NULL));
-                Py_XDECREF(CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallMethodObjArgs(future, set_exception_str, new_exception, NULL)));
+                return PyObject_CallFunctionObjArgs(exception_to_raise, error_message_str, NULL);
         } else {
-                PyObject* new_exception CLEANUP_PY_OBJECT =
-                    CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallFunctionObjArgs(unmapped_error_exception, error_name_str, error_message_str, NULL));
-                Py_XDECREF(CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallMethodObjArgs(future, set_exception_str, new_exception, NULL)));
+                return PyObject_CallFunctionObjArgs(unmapped_error_exception, error_name_str, error_message_str, NULL);
         }
+}
+
+PyObject* _SdBus_exception_from_message(sd_bus_message* message) {
+        return _SdBus_exception_from_error(sd_bus_message_get_error(message));
+}
 
+int future_set_exception_from_message(PyObject* future, sd_bus_message* message) {
+        PyObject* new_exception CLEANUP_PY_OBJECT = CALL_PYTHON_CHECK_RETURN_NEG1(_SdBus_exception_from_message(message));
+        Py_XDECREF(CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallMethodObjArgs(future, set_exception_str, new_exception, NULL)));
         return 0;
 }
 
 static PyObject* SdBus_drive(SdBusObject* self, PyObject* Py_UNUSED(args));
 
 static PyObject* SdBus_get_fd(SdBusObject* self, PyObject* Py_UNUSED(args)) {
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         int file_descriptor = CALL_SD_BUS_AND_CHECK(sd_bus_get_fd(self->sd_bus_ref));
 
         return PyLong_FromLong((long)file_descriptor);
 }
 
+static PyObject* _SdBus_update_events(SdBusObject* self);
+
+static PyObject* _SdBus_register_bus_object(SdBusObject* self) {
+        PyObject* bus_key CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyLong_FromVoidPtr(self->sd_bus_ref));
+        PyObject* bus_object_pointer CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyLong_FromVoidPtr(self));
+        // Lets messages sent outside of SdBus methods find the SdBus
+        CALL_PYTHON_INT_CHECK(PyDict_SetItem(bus_objects_dict, bus_key, bus_object_pointer));
+        Py_RETURN_NONE;
+}
+
 #define CHECK_SD_BUS_READER                                             \
         ({                                                              \
                 if (self->reader_fd == NULL) {                          \
                         CALL_PYTHON_EXPECT_NONE(register_reader(self)); \
                 }                                                       \
+                CALL_PYTHON_EXPECT_NONE(_SdBus_update_events(self));    \
         })
 
+// Loop handles
+//
+// Drive, timer and cork handles reference the bus through their
+// callbacks. SdBus is not tracked by the garbage collector so a
+// handle that never runs would keep the bus alive. Handles are
+// cancelled once the bus can no longer be driven.
+
+static PyObject* _SdBus_cancel_handle(PyObject** handle_ptr) {
+        if (*handle_ptr == NULL) {
+                Py_RETURN_NONE;
+        }
+        PyObject* handle CLEANUP_PY_OBJECT = *handle_ptr;
+        *handle_ptr = NULL;
+        return PyObject_CallMethod(handle, "cancel", "");
+}
+
+static PyObject* _SdBus_cancel_handles(SdBusObject* self) {
+        Py_XDECREF(CALL_PYTHON_AND_CHECK(_SdBus_cancel_handle(&self->drive_handle)));
+        Py_XDECREF(CALL_PYTHON_AND_CHECK(_SdBus_cancel_handle(&self->timer_handle)));
+        Py_XDECREF(CALL_PYTHON_AND_CHECK(_SdBus_cancel_handle(&self->cork_handle)));
+        Py_RETURN_NONE;
+}
+
 PyObject* register_reader(SdBusObject* self) {
         PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
         PyObject* new_reader_fd CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(SdBus_get_fd(self, NULL));
         PyObject* drive_method CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString((PyObject*)self, "drive"));
+        CALL_PYTHON_EXPECT_NONE(_SdBus_register_bus_object(self));
         Py_XDECREF(CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs(running_loop, add_reader_str, new_reader_fd, drive_method, NULL)));
         Py_INCREF(new_reader_fd);
         self->reader_fd = new_reader_fd;
@@ -257,12 +430,279 @@ PyObject* register_reader(SdBusObject* self) {
 PyObject* unregister_reader(SdBusObject* self) {
         PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
         Py_XDECREF(CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs(running_loop, remove_reader_str, self->reader_fd, NULL)));
+        if (self->writer_registered) {
+                Py_XDECREF(CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs(running_loop, remove_writer_str, self->reader_fd, NULL)));
+                self->writer_registered = 0;
+        }
+        return _SdBus_cancel_handles(self);
+}
+
+// Drive budget
+//
+// A drive stops after dispatching drive_budget messages or after
+// drive_time_budget_usec and reschedules itself with call_soon so
+// that other tasks can run. Time budget also bounds sending of
+// corked messages. Messages already read by sd-bus do not
+// make the file descriptor readable again so the reader callback
+// alone would not resume processing.
+//
+// With drive_prioritize_replies signals are collected in
+// deferred_signals and only dispatched once sd-bus has nothing else
+// to process so method replies are never stuck behind a signal flood.
+
+SdBusObject* driving_bus = NULL;  // Bus currently processed by drive
+
+static int _drive_budget_left(SdBusObject* self, unsigned long long dispatched_count, uint64_t deadline_usec) {
+        if (self->drive_budget != 0 && dispatched_count >= self->drive_budget) {
+                return 0;
+        }
+        if (deadline_usec != 0 && _monotonic_usec() >= deadline_usec) {
+                return 0;
+        }
+        return 1;
+}
+
+static PyObject* _SdBus_reschedule_drive(SdBusObject* self) {
+        PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+        PyObject* drive_method CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString((PyObject*)self, "drive"));
+        self->drive_handle = CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs(running_loop, call_soon_str, drive_method, NULL));
         Py_RETURN_NONE;
 }
 
-static PyObject* SdBus_drive(SdBusObject* self, PyObject* Py_UNUSED(args)) {
+// Bus timer
+//
+// sd-bus expires method call timeouts only when processed. Timer is
+// armed with call_later at the earliest deadline reported by
+// sd_bus_get_timeout. Armed timer is only replaced when the new
+// deadline is earlier. Timer that fires before the earliest deadline
+// only drives the bus and arms again.
+
+static PyObject* _SdBus_timer_fired(PyObject* self, PyObject* Py_UNUSED(args)) {
+        SdBusObject* bus_object = (SdBusObject*)self;
+        Py_CLEAR(bus_object->timer_handle);
+        if (sd_bus_is_open(bus_object->sd_bus_ref) <= 0) {
+                // Timer can outlive the calls it was armed for
+                Py_RETURN_NONE;
+        }
+        return SdBus_drive(bus_object, NULL);
+}
+
+static PyMethodDef timer_fired_def = {"_timer_fired", (PyCFunction)_SdBus_timer_fired, METH_NOARGS, NULL};
+
+static PyObject* _SdBus_update_timer(SdBusObject* self) {
+        uint64_t timeout_usec = UINT64_MAX;
+        int return_value = sd_bus_get_timeout(self->sd_bus_ref, &timeout_usec);
+        if (-ENOTCONN == return_value) {
+                // Connection closed, nothing will time out
+                return _SdBus_cancel_handle(&self->timer_handle);
+        }
+        CALL_SD_BUS_AND_CHECK(return_value);
+
+        if (timeout_usec == UINT64_MAX) {
+                // No pending timeouts, armed timer drives once more
+                Py_RETURN_NONE;
+        }
+
+        if (self->timer_handle != NULL && self->timer_deadline_usec <= timeout_usec) {
+                Py_RETURN_NONE;
+        }
+        CALL_PYTHON_EXPECT_NONE(_SdBus_cancel_handle(&self->timer_handle));
+
+        uint64_t now_usec = _monotonic_usec();
+        double delay_seconds = timeout_usec > now_usec ? (double)(timeout_usec - now_usec) / 1000000.0 : 0.0;
+
+        PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+        PyObject* timer_callback CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyCFunction_NewEx(&timer_fired_def, (PyObject*)self, NULL));
+        PyObject* delay_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyFloat_FromDouble(delay_seconds));
+        self->timer_handle = CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs(running_loop, call_later_str, delay_object, timer_callback, NULL));
+        self->timer_deadline_usec = timeout_usec;
+        Py_RETURN_NONE;
+}
+
+// Bus writer
+//
+// sd-bus writes as much as the socket accepts and keeps the rest in
+// the write queue. Loop writer is registered while sd_bus_get_events
+// asks for POLLOUT so drive flushes the queue as soon as the socket
+// is writable instead of on the next incoming message.
+
+static PyObject* _SdBus_update_writer(SdBusObject* self) {
+        int events = sd_bus_get_events(self->sd_bus_ref);
+        if (-ENOTCONN == events) {
+                // Connection closed, nothing to write
+                events = 0;
+        } else {
+                CALL_SD_BUS_AND_CHECK(events);
+        }
+
+        int wants_writer = (events & POLLOUT) != 0;
+        if (wants_writer == self->writer_registered) {
+                Py_RETURN_NONE;
+        }
+
+        PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+        if (wants_writer) {
+                PyObject* drive_method CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString((PyObject*)self, "drive"));
+                Py_XDECREF(CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs(running_loop, add_writer_str, self->reader_fd, drive_method, NULL)));
+        } else {
+                Py_XDECREF(CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs(running_loop, remove_writer_str, self->reader_fd, NULL)));
+        }
+        self->writer_registered = wants_writer;
+        Py_RETURN_NONE;
+}
+
+static PyObject* _SdBus_update_events(SdBusObject* self) {
+        if (self->reader_fd == NULL) {
+                // Not used with asyncio
+                Py_RETURN_NONE;
+        }
+        CALL_PYTHON_EXPECT_NONE(_SdBus_update_writer(self));
+        return _SdBus_update_timer(self);
+}
+
+// Write corking
+//
+// sd-bus writes every sent message right away. While the bus is
+// corked SdBusMessage.send only collects messages in corked_messages
+// and they are sent as one batch followed by a single events update.
+// Explicit cork and uncork calls nest. With cork_sends an async bus
+// flushes at the end of the loop iteration using call_soon.
+//
+// Only SdBusMessage.send is corked: replies, signals and messages
+// sent without expecting reply. Properties snapshot replies are sent
+// the same way. Every other send, including the
+// replies sd-bus sends itself from sd_bus_process, first sends the
+// corked messages so the peer receives messages in the order they
+// were sent.
+
+static int _SdBus_is_corked(SdBusObject* self) {
+        return self->cork_depth > 0 || (self->cork_sends && self->reader_fd != NULL);
+}
+
+static PyObject* _SdBus_cork_message(SdBusObject* self, SdBusMessageObject* message) {
+        if (self->corked_messages == NULL) {
+                self->corked_messages = CALL_PYTHON_AND_CHECK(PyList_New(0));
+        }
+        CALL_PYTHON_INT_CHECK(PyList_Append(self->corked_messages, (PyObject*)message));
+
+        if (self->cork_depth == 0 && self->cork_handle == NULL) {
+                PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+                PyObject* flush_method CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString((PyObject*)self, "flush_corked"));
+                self->cork_handle = CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs(running_loop, call_soon_str, flush_method, NULL));
+        }
+        Py_RETURN_NONE;
+}
+
+static SdBusObject* _SdBus_find_bus_object(sd_bus* bus) {
+        if (bus == NULL) {
+                return NULL;
+        }
+
+        PyObject* bus_key CLEANUP_PY_OBJECT = PyLong_FromVoidPtr(bus);
+        if (bus_key == NULL) {
+                return NULL;
+        }
+        PyObject* bus_object_pointer = PyDict_GetItemWithError(bus_objects_dict, bus_key);
+        if (bus_object_pointer == NULL) {
+                return NULL;
+        }
+        return PyLong_AsVoidPtr(bus_object_pointer);
+}
+
+PyObject* _SdBus_send_message(SdBusMessageObject* message) {
+        SdBusObject* bus_object = _SdBus_find_bus_object(sd_bus_message_get_bus(message->message_ref));
+        PYTHON_ERR_OCCURED;
+
+        if (bus_object != NULL && _SdBus_is_corked(bus_object)) {
+                return _SdBus_cork_message(bus_object, message);
+        }
+
+        CALL_SD_BUS_AND_CHECK(sd_bus_send(NULL, message->message_ref, NULL));
+
+        if (bus_object == NULL || bus_object == driving_bus) {
+                // Drive updates events once it is done
+                Py_RETURN_NONE;
+        }
+        // Message might not fit in to socket buffer
+        return _SdBus_update_events(bus_object);
+}
+
+static PyObject* _SdBus_send_corked_until(SdBusObject* self, uint64_t deadline_usec) {
+        if (self->corked_messages == NULL) {
+                Py_RETURN_NONE;
+        }
+
+        PyObject* corked_messages CLEANUP_PY_OBJECT = self->corked_messages;
+        self->corked_messages = NULL;
+        int first_error = 0;
+        Py_ssize_t messages_count = PyList_Size(corked_messages);
+        Py_ssize_t sent_count = 0;
+        while (sent_count < messages_count) {
+                SdBusMessageObject* message = (SdBusMessageObject*)PyList_GetItem(corked_messages, sent_count);
+                int return_value = sd_bus_send(NULL, message->message_ref, NULL);
+                if (return_value < 0 && first_error == 0) {
+                        // Rest of the batch is still sent
+                        first_error = return_value;
+                }
+                sent_count++;
+                if (deadline_usec != 0 && _monotonic_usec() >= deadline_usec) {
+                        break;
+                }
+        }
+        if (sent_count < messages_count) {
+                // Rest is sent by the rescheduled drive
+                CALL_PYTHON_INT_CHECK(PyList_SetSlice(corked_messages, 0, sent_count, NULL));
+                Py_INCREF(corked_messages);
+                self->corked_messages = corked_messages;
+        }
+        CALL_SD_BUS_AND_CHECK(first_error);
+        Py_RETURN_NONE;
+}
+
+static PyObject* _SdBus_send_corked(SdBusObject* self) {
+        return _SdBus_send_corked_until(self, 0);
+}
+
+static PyObject* SdBus_flush_corked(SdBusObject* self, PyObject* Py_UNUSED(args)) {
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
+        Py_CLEAR(self->cork_handle);
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
+
+        if (self == driving_bus) {
+                Py_RETURN_NONE;
+        }
+        return _SdBus_update_events(self);
+}
+
+static PyObject* SdBus_cork(SdBusObject* self, PyObject* Py_UNUSED(args)) {
+        CALL_PYTHON_EXPECT_NONE(_SdBus_register_bus_object(self));
+        self->cork_depth++;
+        Py_RETURN_NONE;
+}
+
+static PyObject* SdBus_uncork(SdBusObject* self, PyObject* Py_UNUSED(args)) {
+        if (self->cork_depth == 0) {
+                PyErr_SetString(PyExc_RuntimeError, "Bus is not corked");
+                return NULL;
+        }
+        self->cork_depth--;
+        if (self->cork_depth > 0) {
+                Py_RETURN_NONE;
+        }
+        return SdBus_flush_corked(self, NULL);
+}
+
+static PyObject* _SdBus_process(SdBusObject* self, unsigned long long* dispatched_count, uint64_t deadline_usec) {
         int return_value = 1;
         while (return_value > 0) {
+                if (!_drive_budget_left(self, *dispatched_count, deadline_usec)) {
+                        return _SdBus_reschedule_drive(self);
+                }
+                CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked_until(self, deadline_usec));
+                if (self->corked_messages != NULL) {
+                        // Corked messages go out before anything sd-bus sends
+                        return _SdBus_reschedule_drive(self);
+                }
                 return_value = sd_bus_process(self->sd_bus_ref, NULL);
                 if (return_value < 0) {
                         CALL_PYTHON_AND_CHECK(unregister_reader(self));
@@ -279,69 +719,282 @@ static PyObject* SdBus_drive(SdBusObject* self, PyObject* Py_UNUSED(args)) {
                 if (PyErr_Occurred()) {
                         return NULL;
                 }
+                (*dispatched_count)++;
         }
 
+        if (self->deferred_signals == NULL || PyList_Size(self->deferred_signals) == 0) {
+                Py_RETURN_NONE;
+        }
+
+        // Read queue is empty, replies were already dispatched
+        PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+        Py_ssize_t signals_count = PyList_Size(self->deferred_signals);
+        Py_ssize_t dispatched_signals = 0;
+        for (; dispatched_signals < signals_count; ++dispatched_signals) {
+                if (!_drive_budget_left(self, *dispatched_count, deadline_usec)) {
+                        break;
+                }
+                PyObject* deferred_signal = PyList_GetItem(self->deferred_signals, dispatched_signals);
+                Py_XDECREF(CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs(running_loop, call_soon_str, PyTuple_GetItem(deferred_signal, 0),
+                                                                            PyTuple_GetItem(deferred_signal, 1), NULL)));
+                (*dispatched_count)++;
+        }
+        CALL_PYTHON_INT_CHECK(PyList_SetSlice(self->deferred_signals, 0, dispatched_signals, NULL));
+        if (dispatched_signals < signals_count) {
+                return _SdBus_reschedule_drive(self);
+        }
         Py_RETURN_NONE;
 }
 
-int SdBus_async_callback(sd_bus_message* m,
-                         void* userdata,  // Should be the asyncio.Future
-                         sd_bus_error* Py_UNUSED(ret_error)) {
-        sd_bus_message* reply_message __attribute__((cleanup(sd_bus_message_unrefp))) = sd_bus_message_ref(m);
-        PyObject* py_future = userdata;
-        PyObject* is_cancelled CLEANUP_PY_OBJECT = PyObject_CallMethod(py_future, "cancelled", "");
-        if (Py_True == is_cancelled) {
-                // A bit unpythonic but SdBus_drive does not error out
-                return 0;
+static PyObject* SdBus_drive(SdBusObject* self, PyObject* Py_UNUSED(args)) {
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
+        // Reader callback can run before the rescheduled drive
+        Py_XDECREF(CALL_PYTHON_AND_CHECK(_SdBus_cancel_handle(&self->drive_handle)));
+        unsigned long long dispatched_count = 0;
+        uint64_t deadline_usec = self->drive_time_budget_usec != 0 ? _monotonic_usec() + self->drive_time_budget_usec : 0;
+
+        SdBusObject* previous_driving_bus = driving_bus;
+        driving_bus = self;
+        PyObject* result = _SdBus_process(self, &dispatched_count, deadline_usec);
+        driving_bus = previous_driving_bus;
+        if (result == NULL || self->reader_fd == NULL) {
+                return result;
         }
 
-        if (!sd_bus_message_is_method_error(m, NULL)) {
-                // Not Error, set Future result to new message object
+        Py_DECREF(result);
+        return _SdBus_update_events(self);
+}
 
-                SdBusMessageObject* reply_message_object CLEANUP_SD_BUS_MESSAGE = (SdBusMessageObject*)SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class);
-                if (reply_message_object == NULL) {
-                        return -1;
+static PyObject* _SdBus_start_pending_call(SdBusObject* self, PyObject* running_loop, SdBusMessageObject* call_message, uint64_t call_timeout_usec) {
+        SdBusPendingCallObject* new_pending_call CLEANUP_SD_BUS_PENDING_CALL =
+            (SdBusPendingCallObject*)CALL_PYTHON_AND_CHECK(_SdBusPendingCall_new((PyObject*)self, running_loop));
+
+        // Pending call owns the slot, reply callback borrows the pending call
+        CALL_SD_BUS_AND_CHECK(sd_bus_call_async(self->sd_bus_ref, &new_pending_call->slot_ref, call_message->message_ref, _SdBusPendingCall_callback,
+                                                new_pending_call, call_timeout_usec));
+        self->pending_calls_count++;
+
+        Py_INCREF(new_pending_call);
+        return (PyObject*)new_pending_call;
+}
+
+static PyObject* SdBus_call_async(SdBusObject* self, PyObject* args, PyObject* kwargs) {
+        static char* kwlist[] = {"", "timeout_usec", "deadline_usec", NULL};
+        SdBusMessageObject* call_message = NULL;
+        unsigned long long timeout_usec = 0;
+        unsigned long long deadline_usec = 0;
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTupleAndKeywords(args, kwargs, "O!|$KK", kwlist, (PyTypeObject*)SdBusMessage_class, &call_message, &timeout_usec,
+                                                           &deadline_usec));
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
+        PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
+        PyObject* new_pending_call CLEANUP_PY_OBJECT =
+            CALL_PYTHON_AND_CHECK(_SdBus_start_pending_call(self, running_loop, call_message, _call_timeout_usec(timeout_usec, deadline_usec)));
+
+        CHECK_SD_BUS_READER;
+        Py_INCREF(new_pending_call);
+        return new_pending_call;
+}
+
+// Pipelined calls
+//
+// call_many and call_many_async queue every message before waiting
+// for any reply. Results list has the reply message or the D-Bus
+// error exception of every call in the order of messages.
+//
+// The batch is sent after a single flush of corked messages and is
+// followed by a single events update. sd-bus has no way to hold
+// method calls so every call is still written as it is queued.
+//
+// call_many processes the bus itself and waits on the socket with
+// the GIL released. Reply callbacks only store the results. Same as
+// sd_bus_call it tracks the timeout itself so calls without reply
+// get DbusTimeoutError instead of sd-bus synthetic no reply error.
+// sd_bus_process also dispatches other messages of the bus such as
+// method calls to exported objects and signal callbacks. Used
+// outside of asyncio loop those run before call_many returns.
+
+typedef struct {
+        sd_bus_slot* slot_ref;
+        PyObject* results;  // Borrowed results list
+        Py_ssize_t index;
+        Py_ssize_t* replies_left;
+} _CallManyItem;
+
+static PyObject* _call_many_messages_list(PyObject* messages_iterable) {
+        PyObject* messages CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PySequence_List(messages_iterable));
+        Py_ssize_t messages_count = PyList_Size(messages);
+        for (Py_ssize_t i = 0; i < messages_count; ++i) {
+                PyObject* call_message = PyList_GetItem(messages, i);
+                if (!PyType_IsSubtype(Py_TYPE(call_message), (PyTypeObject*)SdBusMessage_class)) {
+                        PyErr_Format(PyExc_TypeError, "Expected SdBusMessage, got %R", call_message);
+                        return NULL;
                 }
-                _SdBusMessage_set_messsage(reply_message_object, reply_message);
-                PyObject* return_object CLEANUP_PY_OBJECT = PyObject_CallMethod(py_future, "set_result", "O", reply_message_object);
-                if (return_object == NULL) {
-                        return -1;
+        }
+        Py_INCREF(messages);
+        return messages;
+}
+
+static int _SdBus_call_many_callback(sd_bus_message* m, void* userdata, sd_bus_error* Py_UNUSED(ret_error)) {
+        _CallManyItem* item = userdata;
+        item->slot_ref = sd_bus_slot_unref(item->slot_ref);
+        (*item->replies_left)--;
+
+        if (sd_bus_message_is_method_error(m, NULL)) {
+                PyObject* new_exception = CALL_PYTHON_CHECK_RETURN_NEG1(_SdBus_exception_from_message(m));
+                return PyList_SetItem(item->results, item->index, new_exception);
+        }
+
+        SdBusMessageObject* reply_message_object =
+            (SdBusMessageObject*)CALL_PYTHON_CHECK_RETURN_NEG1(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
+        _SdBusMessage_set_messsage(reply_message_object, m);
+        return PyList_SetItem(item->results, item->index, (PyObject*)reply_message_object);
+}
+
+static int _SdBus_call_many_timeout(_CallManyItem* item) {
+        item->slot_ref = sd_bus_slot_unref(item->slot_ref);
+        (*item->replies_left)--;
+
+        sd_bus_error error __attribute__((cleanup(sd_bus_error_free))) = SD_BUS_ERROR_NULL;
+        sd_bus_error_set_errno(&error, ETIMEDOUT);
+        PyObject* new_exception = CALL_PYTHON_CHECK_RETURN_NEG1(_SdBus_exception_from_error(&error));
+        return PyList_SetItem(item->results, item->index, new_exception);
+}
+
+static PyObject* _SdBus_call_many_run(SdBusObject* self, PyObject* messages, _CallManyItem* items, PyObject* results, uint64_t call_timeout_usec) {
+        Py_ssize_t messages_count = PyList_Size(messages);
+        Py_ssize_t replies_left = 0;
+        if (call_timeout_usec == 0) {
+                CALL_SD_BUS_AND_CHECK(sd_bus_get_method_call_timeout(self->sd_bus_ref, &call_timeout_usec));
+        }
+        // Taken before sending so it expires before sd-bus timeouts
+        uint64_t start_usec = _monotonic_usec();
+        uint64_t deadline_usec = call_timeout_usec < UINT64_MAX - start_usec ? start_usec + call_timeout_usec : UINT64_MAX;
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
+        for (Py_ssize_t i = 0; i < messages_count; ++i) {
+                SdBusMessageObject* call_message = (SdBusMessageObject*)PyList_GetItem(messages, i);
+                items[i].results = results;
+                items[i].index = i;
+                items[i].replies_left = &replies_left;
+                CALL_SD_BUS_AND_CHECK(sd_bus_call_async(self->sd_bus_ref, &items[i].slot_ref, call_message->message_ref, _SdBus_call_many_callback,
+                                                        &items[i], call_timeout_usec));
+                replies_left++;
+        }
+
+        while (replies_left > 0) {
+                uint64_t now_usec = _monotonic_usec();
+                if (now_usec >= deadline_usec) {
+                        for (Py_ssize_t i = 0; i < messages_count; ++i) {
+                                if (items[i].slot_ref != NULL) {
+                                        CALL_PYTHON_INT_CHECK(_SdBus_call_many_timeout(&items[i]));
+                                }
+                        }
+                        break;
                 }
-        } else {
-                // An Error, set exception
-                if (future_set_exception_from_message(py_future, m) < 0) {
-                        return -1;
+
+                CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
+                int return_value = sd_bus_process(self->sd_bus_ref, NULL);
+                if (PyErr_Occurred()) {
+                        return NULL;
                 }
+                CALL_SD_BUS_AND_CHECK(return_value);
+                // Expired call is dispatched without reporting progress
+                if (return_value > 0 || replies_left == 0) {
+                        continue;
+                }
+
+                _BlockingCall* blocking_call = _SdBus_begin_blocking_call(self);
+                if (blocking_call == NULL) {
+                        return NULL;
+                }
+                Py_BEGIN_ALLOW_THREADS;
+                return_value = sd_bus_wait(self->sd_bus_ref, deadline_usec - now_usec);
+                Py_END_ALLOW_THREADS;
+                _SdBus_end_blocking_call(self, blocking_call);
+                CALL_SD_BUS_AND_CHECK(return_value);
         }
 
-        return 0;
+        Py_INCREF(results);
+        return results;
 }
 
-#ifndef Py_LIMITED_API
-static PyObject* SdBus_call_async(SdBusObject* self, PyObject* const* args, Py_ssize_t nargs) {
-        SD_BUS_PY_CHECK_ARGS_NUMBER(1);
-        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(0, _check_sdbus_message);
+static PyObject* SdBus_call_many(SdBusObject* self, PyObject* args, PyObject* kwargs) {
+        static char* kwlist[] = {"", "timeout_usec", "deadline_usec", NULL};
+        PyObject* messages_iterable = NULL;
+        unsigned long long timeout_usec = 0;
+        unsigned long long deadline_usec = 0;
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTupleAndKeywords(args, kwargs, "O|$KK", kwlist, &messages_iterable, &timeout_usec, &deadline_usec));
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
+        PyObject* messages CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_call_many_messages_list(messages_iterable));
+        Py_ssize_t messages_count = PyList_Size(messages);
+
+        PyObject* results CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyList_New(messages_count));
+        for (Py_ssize_t i = 0; i < messages_count; ++i) {
+                Py_INCREF(Py_None);
+                PyList_SetItem(results, i, Py_None);
+        }
+        if (messages_count == 0) {
+                Py_INCREF(results);
+                return results;
+        }
 
-        SdBusMessageObject* call_message = (SdBusMessageObject*)args[0];
-#else
-static PyObject* SdBus_call_async(SdBusObject* self, PyObject* args) {
-        SdBusMessageObject* call_message = NULL;
-        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "O", &call_message, NULL));
-#endif
-        PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+        _CallManyItem* items = PyMem_Calloc((size_t)messages_count, sizeof(_CallManyItem));
+        if (items == NULL) {
+                return PyErr_NoMemory();
+        }
+        PyObject* return_object = _SdBus_call_many_run(self, messages, items, results, _call_timeout_usec(timeout_usec, deadline_usec));
+        // Calls left without reply on error
+        for (Py_ssize_t i = 0; i < messages_count; ++i) {
+                sd_bus_slot_unref(items[i].slot_ref);
+        }
+        PyMem_Free(items);
+        return return_object;
+}
 
-        PyObject* new_future = CALL_PYTHON_AND_CHECK(PyObject_CallMethod(running_loop, "create_future", ""));
+static PyObject* SdBus_call_many_async(SdBusObject* self, PyObject* args, PyObject* kwargs) {
+        static char* kwlist[] = {"", "timeout_usec", "deadline_usec", NULL};
+        PyObject* messages_iterable = NULL;
+        unsigned long long timeout_usec = 0;
+        unsigned long long deadline_usec = 0;
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTupleAndKeywords(args, kwargs, "O|$KK", kwlist, &messages_iterable, &timeout_usec, &deadline_usec));
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
+        PyObject* messages CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_call_many_messages_list(messages_iterable));
+        Py_ssize_t messages_count = PyList_Size(messages);
+        uint64_t call_timeout_usec = _call_timeout_usec(timeout_usec, deadline_usec);
 
-        SdBusSlotObject* new_slot_object CLEANUP_SD_BUS_SLOT = (SdBusSlotObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusSlot_class));
+        PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+        PyObject* pending_calls CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyTuple_New(messages_count));
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
+        for (Py_ssize_t i = 0; i < messages_count; ++i) {
+                PyObject* new_pending_call =
+                    CALL_PYTHON_AND_CHECK(_SdBus_start_pending_call(self, running_loop, (SdBusMessageObject*)PyList_GetItem(messages, i), call_timeout_usec));
+                PyTuple_SetItem(pending_calls, i, new_pending_call);
+        }
 
-        CALL_SD_BUS_AND_CHECK(
-            sd_bus_call_async(self->sd_bus_ref, &new_slot_object->slot_ref, call_message->message_ref, SdBus_async_callback, new_future, (uint64_t)0));
+        CHECK_SD_BUS_READER;
+        PyObject* gather_kwargs CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(Py_BuildValue("{sO}", "return_exceptions", Py_True));
+        return PyObject_Call(asyncio_gather, pending_calls, gather_kwargs);
+}
 
-        if (PyObject_SetAttrString(new_future, "_sd_bus_py_slot", (PyObject*)new_slot_object) < 0) {
-                return NULL;
+// Exported objects must be served even if the bus never sends
+// anything itself. For example, the server end of peer connection.
+static PyObject* _SdBus_serve_exported(SdBusObject* self) {
+        if (self->reader_fd != NULL) {
+                Py_RETURN_NONE;
+        }
+
+        PyObject* running_loop CLEANUP_PY_OBJECT = PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL);
+        if (running_loop == NULL) {
+                if (!PyErr_ExceptionMatches(PyExc_RuntimeError)) {
+                        return NULL;
+                }
+                // Exported before loop started. Reader is added on first call.
+                PyErr_Clear();
+                Py_RETURN_NONE;
         }
+
         CHECK_SD_BUS_READER;
-        return new_future;
+        Py_RETURN_NONE;
 }
 
 #ifndef Py_LIMITED_API
@@ -365,14 +1018,16 @@ static PyObject* SdBus_add_interface(SdBusObject* self, PyObject* args) {
         const char* interface_name_char_ptr = NULL;
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "Oss", &interface_object, &path_char_ptr, &interface_name_char_ptr, NULL));
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         PyObject* create_vtable_name CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyUnicode_FromString("_create_vtable"));
 
         Py_XDECREF(CALL_PYTHON_AND_CHECK(PyObject_CallMethodObjArgs((PyObject*)interface_object, create_vtable_name, NULL)));
 
         CALL_SD_BUS_AND_CHECK(sd_bus_add_object_vtable(self->sd_bus_ref, &interface_object->interface_slot->slot_ref, path_char_ptr, interface_name_char_ptr,
-                                                       interface_object->vtable, interface_object));
+                                                       interface_object->vtable, interface_object->members));
+        CALL_PYTHON_INT_CHECK(_SdBusInterface_add_snapshot_handler(interface_object, self->sd_bus_ref, path_char_ptr, interface_name_char_ptr));
 
-        Py_RETURN_NONE;
+        return _SdBus_serve_exported(self);
 }
 
 int _SdBus_signal_callback(sd_bus_message* m, void* userdata, sd_bus_error* Py_UNUSED(ret_error)) {
@@ -384,24 +1039,39 @@ int _SdBus_signal_callback(sd_bus_message* m, void* userdata, sd_bus_error* Py_U
             (SdBusMessageObject*)CALL_PYTHON_CHECK_RETURN_NEG1(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
         _SdBusMessage_set_messsage(new_message_object, m);
 
+        if (driving_bus != NULL && driving_bus->drive_prioritize_replies) {
+                if (driving_bus->deferred_signals == NULL) {
+                        driving_bus->deferred_signals = CALL_PYTHON_CHECK_RETURN_NEG1(PyList_New(0));
+                }
+                PyObject* deferred_signal CLEANUP_PY_OBJECT = CALL_PYTHON_CHECK_RETURN_NEG1(PyTuple_Pack(2, signal_callback, new_message_object));
+                return PyList_Append(driving_bus->deferred_signals, deferred_signal);
+        }
+
         Py_XDECREF(CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallMethodObjArgs(running_loop, call_soon_str, signal_callback, new_message_object, NULL)));
 
         return 0;
 }
 
-int _SdBus_match_signal_instant_callback(sd_bus_message* m, void* userdata, sd_bus_error* Py_UNUSED(ret_error)) {
-        PyObject* new_future = userdata;
+static int _SdBus_match_signal_installed(PyObject* new_future) {
+        SdBusSlotObject* slot_object CLEANUP_SD_BUS_SLOT =
+            (SdBusSlotObject*)CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_GetAttrString(new_future, "_sd_bus_slot"));
 
-        if (!sd_bus_message_is_method_error(m, NULL)) {
-                SdBusSlotObject* slot_object CLEANUP_SD_BUS_SLOT =
-                    (SdBusSlotObject*)CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_GetAttrString(new_future, "_sd_bus_slot"));
+        Py_XDECREF(CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallMethodObjArgs(new_future, set_result_str, slot_object, NULL)));
 
-                Py_XDECREF(CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallMethodObjArgs(new_future, set_result_str, slot_object, NULL)));
+        PyObject* signal_callback = CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_GetAttrString(new_future, "_sd_bus_signal_callback"));
 
-                PyObject* signal_callback = CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_GetAttrString(new_future, "_sd_bus_signal_callback"));
+        sd_bus_slot_set_userdata(slot_object->slot_ref, signal_callback);
+        sd_bus_slot_set_destroy_callback(slot_object->slot_ref, (sd_bus_destroy_t)Py_DecRef);
+        return 0;
+}
+
+int _SdBus_match_signal_instant_callback(sd_bus_message* m, void* userdata, sd_bus_error* Py_UNUSED(ret_error)) {
+        PyObject* new_future = userdata;
 
-                sd_bus_slot_set_userdata(slot_object->slot_ref, signal_callback);
-                sd_bus_slot_set_destroy_callback(slot_object->slot_ref, (sd_bus_destroy_t)Py_DecRef);
+        if (!sd_bus_message_is_method_error(m, NULL)) {
+                if (_SdBus_match_signal_installed(new_future) < 0) {
+                        return -1;
+                }
         } else {
                 if (future_set_exception_from_message(new_future, m) < 0) {
                         return -1;
@@ -441,6 +1111,7 @@ static PyObject* SdBus_match_signal_async(SdBusObject* self, PyObject* args) {
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "zzzzO", &sender_service_char_ptr, &path_name_char_ptr, &interface_name_char_ptr, &member_name_char_ptr,
                                                 &signal_callback, NULL));
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
         PyObject* new_future CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallMethod(running_loop, "create_future", ""));
 
@@ -450,10 +1121,22 @@ static PyObject* SdBus_match_signal_async(SdBusObject* self, PyObject* args) {
         CALL_PYTHON_INT_CHECK(PyObject_SetAttrString(new_future, "_sd_bus_slot", (PyObject*)new_slot));
         CALL_PYTHON_INT_CHECK(PyObject_SetAttrString(new_future, "_sd_bus_signal_callback", signal_callback));
 
+        int is_bus_client = sd_bus_is_bus_client(self->sd_bus_ref);
+        if (!is_bus_client) {
+                // Messages from peer have no sender
+                sender_service_char_ptr = NULL;
+        }
+
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
         CALL_SD_BUS_AND_CHECK(sd_bus_match_signal_async(self->sd_bus_ref, &new_slot->slot_ref, sender_service_char_ptr, path_name_char_ptr,
                                                         interface_name_char_ptr, member_name_char_ptr, _SdBus_signal_callback,
                                                         _SdBus_match_signal_instant_callback, new_future));
 
+        if (!is_bus_client) {
+                // Peer connections only match locally and never call install callback
+                CALL_PYTHON_INT_CHECK(_SdBus_match_signal_installed(new_future));
+        }
+
         CHECK_SD_BUS_READER;
         Py_INCREF(new_future);
         return new_future;
@@ -523,6 +1206,8 @@ static PyObject* SdBus_request_name_async(SdBusObject* self, PyObject* args) {
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "sK", &service_name_char_ptr, &flags_long_long, NULL));
         uint64_t flags = (uint64_t)flags_long_long;
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
         PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
         PyObject* new_future = CALL_PYTHON_AND_CHECK(PyObject_CallMethod(running_loop, "create_future", ""));
         SdBusSlotObject* new_slot_object CLEANUP_SD_BUS_SLOT = (SdBusSlotObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusSlot_class));
@@ -553,7 +1238,16 @@ static PyObject* SdBus_request_name(SdBusObject* self, PyObject* args) {
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "sK", &service_name_char_ptr, &flags_long_long, NULL));
         uint64_t flags = (uint64_t)flags_long_long;
 #endif
-        int request_name_return_code = sd_bus_request_name(self->sd_bus_ref, service_name_char_ptr, flags);
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
+        _BlockingCall* blocking_call = _SdBus_begin_blocking_call(self);
+        if (blocking_call == NULL) {
+                return NULL;
+        }
+        int request_name_return_code = 0;
+        Py_BEGIN_ALLOW_THREADS;
+        request_name_return_code = sd_bus_request_name(self->sd_bus_ref, service_name_char_ptr, flags);
+        Py_END_ALLOW_THREADS;
+        _SdBus_end_blocking_call(self, blocking_call);
         switch (request_name_return_code) {
                 case -EEXIST:
                         return PyErr_Format(exception_request_name_exists, "Name \"%s\" already owned.", service_name_char_ptr, NULL);
@@ -585,6 +1279,7 @@ static SdBusSlotObject* SdBus_add_object_manager(SdBusObject* self, PyObject* ar
         const char* object_manager_path = NULL;
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "s", &object_manager_path, NULL));
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         SdBusSlotObject* new_slot_object CLEANUP_SD_BUS_SLOT = (SdBusSlotObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusSlot_class));
 
         CALL_SD_BUS_AND_CHECK(sd_bus_add_object_manager(self->sd_bus_ref, &new_slot_object->slot_ref, object_manager_path));
@@ -604,9 +1299,11 @@ static PyObject* SdBus_emit_object_added(SdBusObject* self, PyObject* args) {
         const char* added_object_path = NULL;
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "s", &added_object_path, NULL));
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
         CALL_SD_BUS_AND_CHECK(sd_bus_emit_object_added(self->sd_bus_ref, added_object_path));
 
-        Py_RETURN_NONE;
+        return _SdBus_update_events(self);
 }
 
 #ifndef Py_LIMITED_API
@@ -620,24 +1317,35 @@ static PyObject* SdBus_emit_object_removed(SdBusObject* self, PyObject* args) {
         const char* removed_object_path = NULL;
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "s", &removed_object_path, NULL));
 #endif
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
+        CALL_PYTHON_EXPECT_NONE(_SdBus_send_corked(self));
         CALL_SD_BUS_AND_CHECK(sd_bus_emit_object_removed(self->sd_bus_ref, removed_object_path));
 
-        Py_RETURN_NONE;
+        return _SdBus_update_events(self);
 }
 
 static PyObject* SdBus_close(SdBusObject* self, PyObject* Py_UNUSED(args)) {
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         sd_bus_close(self->sd_bus_ref);
-        Py_RETURN_NONE;
+        // Closed bus drops the messages it has not sent yet
+        Py_CLEAR(self->corked_messages);
+        return _SdBus_cancel_handles(self);
 }
 
 static PyObject* SdBus_start(SdBusObject* self, PyObject* Py_UNUSED(args)) {
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         CALL_SD_BUS_AND_CHECK(sd_bus_start(self->sd_bus_ref));
         Py_RETURN_NONE;
 }
 
 static PyMethodDef SdBus_methods[] = {
-    {"call", (SD_BUS_PY_FUNC_TYPE)SdBus_call, SD_BUS_PY_METH, PyDoc_STR("Send message and block until the reply.")},
-    {"call_async", (SD_BUS_PY_FUNC_TYPE)SdBus_call_async, SD_BUS_PY_METH, PyDoc_STR("Async send message, returns awaitable future.")},
+    {"call", (PyCFunction)(void (*)(void))SdBus_call, METH_VARARGS | METH_KEYWORDS, PyDoc_STR("Send message and block until the reply.")},
+    {"call_async", (PyCFunction)(void (*)(void))SdBus_call_async, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR("Async send message, returns awaitable future.")},
+    {"call_many", (PyCFunction)(void (*)(void))SdBus_call_many, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR("Send all messages and block until every reply. Processes other messages of the bus while waiting. Returns list of replies and errors.")},
+    {"call_many_async", (PyCFunction)(void (*)(void))SdBus_call_many_async, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR("Async send all messages, returns awaitable of list of replies and errors.")},
     {"drive", (PyCFunction)SdBus_drive, METH_NOARGS, PyDoc_STR("Drive connection.")},
     {"get_fd", (SD_BUS_PY_FUNC_TYPE)SdBus_get_fd, SD_BUS_PY_METH, PyDoc_STR("Get file descriptor to poll on.")},
     {"new_method_call_message", (SD_BUS_PY_FUNC_TYPE)SdBus_new_method_call_message, SD_BUS_PY_METH, PyDoc_STR("Create new empty method call message.")},
@@ -652,12 +1360,16 @@ static PyMethodDef SdBus_methods[] = {
     {"add_object_manager", (SD_BUS_PY_FUNC_TYPE)SdBus_add_object_manager, SD_BUS_PY_METH, PyDoc_STR("Add object manager at the path.")},
     {"emit_object_added", (SD_BUS_PY_FUNC_TYPE)SdBus_emit_object_added, SD_BUS_PY_METH, PyDoc_STR("Emit signal that object was added.")},
     {"emit_object_removed", (SD_BUS_PY_FUNC_TYPE)SdBus_emit_object_removed, SD_BUS_PY_METH, PyDoc_STR("Emit signal that object was removed.")},
+    {"cork", (PyCFunction)SdBus_cork, METH_NOARGS, PyDoc_STR("Collect sent messages until matching uncork.")},
+    {"uncork", (PyCFunction)SdBus_uncork, METH_NOARGS, PyDoc_STR("End cork. Outermost uncork sends collected messages.")},
+    {"flush_corked", (PyCFunction)SdBus_flush_corked, METH_NOARGS, PyDoc_STR("Send messages collected while corked.")},
     {"close", (PyCFunction)SdBus_close, METH_NOARGS, PyDoc_STR("Close connection.")},
     {"start", (PyCFunction)SdBus_start, METH_NOARGS, PyDoc_STR("Start connection.")},
     {NULL, NULL, 0, NULL},
 };
 
 static PyObject* SdBus_address_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         const char* bus_address = NULL;
         int get_address_result = sd_bus_get_address(self->sd_bus_ref, &bus_address);
         if (-ENODATA == get_address_result) {
@@ -670,6 +1382,7 @@ static PyObject* SdBus_address_getter(SdBusObject* self, void* Py_UNUSED(closure
 }
 
 static PyObject* SdBus_method_call_timeout_usec_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         uint64_t timeout_usec = 0;
         CALL_SD_BUS_AND_CHECK(sd_bus_get_method_call_timeout(self->sd_bus_ref, &timeout_usec));
 
@@ -677,6 +1390,7 @@ static PyObject* SdBus_method_call_timeout_usec_getter(SdBusObject* self, void*
 }
 
 static int SdBus_method_call_timeout_usec_setter(SdBusObject* self, PyObject* new_value, void* Py_UNUSED(closure)) {
+        _SdBus_wait_blocking_call(self->sd_bus_ref);
         if (NULL == new_value) {
                 PyErr_SetString(PyExc_ValueError, "Cannot delete method call timeout value");
                 return -1;
@@ -690,10 +1404,161 @@ static int SdBus_method_call_timeout_usec_setter(SdBusObject* self, PyObject* ne
         return 0;
 }
 
+static PyObject* SdBus_string_cache_hits_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        PyObject* cache_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusStringCache_capsule_for_bus(self->sd_bus_ref, 0));
+        SdBusStringCache* string_cache = _SdBusStringCache_from_capsule(cache_capsule);
+
+        return PyLong_FromUnsignedLongLong(string_cache != NULL ? string_cache->hits : 0);
+}
+
+static PyObject* SdBus_string_cache_misses_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        PyObject* cache_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusStringCache_capsule_for_bus(self->sd_bus_ref, 0));
+        SdBusStringCache* string_cache = _SdBusStringCache_from_capsule(cache_capsule);
+
+        return PyLong_FromUnsignedLongLong(string_cache != NULL ? string_cache->misses : 0);
+}
+
+static PyObject* SdBus_pending_calls_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        return PyLong_FromUnsignedLongLong(self->pending_calls_count);
+}
+
+static PyObject* SdBus_cancelled_calls_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        return PyLong_FromUnsignedLongLong(self->cancelled_calls_count);
+}
+
+static PyObject* SdBus_string_cache_size_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        PyObject* cache_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusStringCache_capsule_for_bus(self->sd_bus_ref, 0));
+        SdBusStringCache* string_cache = _SdBusStringCache_from_capsule(cache_capsule);
+
+        return PyLong_FromSize_t(string_cache != NULL ? string_cache->entries_count : SD_BUS_STRING_CACHE_DEFAULT_SIZE);
+}
+
+static int SdBus_string_cache_size_setter(SdBusObject* self, PyObject* new_value, void* Py_UNUSED(closure)) {
+        if (NULL == new_value) {
+                PyErr_SetString(PyExc_AttributeError, "Can't delete string_cache_size");
+                return -1;
+        }
+
+        Py_ssize_t new_size = PyLong_AsSsize_t(new_value);
+        if (new_size == -1 && PyErr_Occurred()) {
+                return -1;
+        }
+        if (new_size < 0) {
+                PyErr_SetString(PyExc_ValueError, "String cache size can't be negative");
+                return -1;
+        }
+        // Resizing also drops cached strings and resets counters
+        return _SdBusStringCache_resize(self->sd_bus_ref, (size_t)new_size);
+}
+
+static int _set_drive_budget_value(PyObject* new_value, unsigned long long* budget_value) {
+        if (NULL == new_value) {
+                PyErr_SetString(PyExc_AttributeError, "Can't delete drive budget");
+                return -1;
+        }
+
+        unsigned long long new_budget = PyLong_AsUnsignedLongLong(new_value);
+        if ((((unsigned long long)-1) == new_budget) && (PyErr_Occurred() != NULL)) {
+                return -1;
+        }
+        *budget_value = new_budget;
+        return 0;
+}
+
+static PyObject* SdBus_drive_budget_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        return PyLong_FromUnsignedLongLong(self->drive_budget);
+}
+
+static int SdBus_drive_budget_setter(SdBusObject* self, PyObject* new_value, void* Py_UNUSED(closure)) {
+        return _set_drive_budget_value(new_value, &self->drive_budget);
+}
+
+static PyObject* SdBus_drive_time_budget_usec_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        return PyLong_FromUnsignedLongLong(self->drive_time_budget_usec);
+}
+
+static int SdBus_drive_time_budget_usec_setter(SdBusObject* self, PyObject* new_value, void* Py_UNUSED(closure)) {
+        return _set_drive_budget_value(new_value, &self->drive_time_budget_usec);
+}
+
+static PyObject* SdBus_drive_prioritize_replies_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        return PyBool_FromLong(self->drive_prioritize_replies);
+}
+
+static int SdBus_drive_prioritize_replies_setter(SdBusObject* self, PyObject* new_value, void* Py_UNUSED(closure)) {
+        if (NULL == new_value) {
+                PyErr_SetString(PyExc_AttributeError, "Can't delete drive_prioritize_replies");
+                return -1;
+        }
+
+        int new_bool = PyObject_IsTrue(new_value);
+        if (new_bool < 0) {
+                return -1;
+        }
+        self->drive_prioritize_replies = new_bool;
+        return 0;
+}
+
+static PyObject* SdBus_cork_sends_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        return PyBool_FromLong(self->cork_sends);
+}
+
+static int SdBus_cork_sends_setter(SdBusObject* self, PyObject* new_value, void* Py_UNUSED(closure)) {
+        if (NULL == new_value) {
+                PyErr_SetString(PyExc_AttributeError, "Can't delete cork_sends");
+                return -1;
+        }
+
+        int new_bool = PyObject_IsTrue(new_value);
+        if (new_bool < 0) {
+                return -1;
+        }
+        self->cork_sends = new_bool;
+        return 0;
+}
+
+static PyObject* SdBus_eager_dispatch_getter(SdBusObject* self, void* Py_UNUSED(closure)) {
+        return PyBool_FromLong(self->eager_dispatch);
+}
+
+static int SdBus_eager_dispatch_setter(SdBusObject* self, PyObject* new_value, void* Py_UNUSED(closure)) {
+        if (NULL == new_value) {
+                PyErr_SetString(PyExc_AttributeError, "Can't delete eager_dispatch");
+                return -1;
+        }
+
+        int new_bool = PyObject_IsTrue(new_value);
+        if (new_bool < 0) {
+                return -1;
+        }
+        if (new_bool && asyncio_eager_task_class == NULL) {
+                PyErr_SetString(PyExc_NotImplementedError, "eager_dispatch needs asyncio tasks with eager_start (Python 3.12)");
+                return -1;
+        }
+        self->eager_dispatch = new_bool;
+        return 0;
+}
+
 static PyGetSetDef SdBus_properies[] = {
     {"address", (getter)SdBus_address_getter, NULL, PyDoc_STR("Bus address."), NULL},
     {"method_call_timeout_usec", (getter)SdBus_method_call_timeout_usec_getter, (setter)SdBus_method_call_timeout_usec_setter,
      PyDoc_STR("D-Bus call timeout in microseconds."), NULL},
+    {"string_cache_hits", (getter)SdBus_string_cache_hits_getter, NULL, PyDoc_STR("Number of decoded strings found in string cache."), NULL},
+    {"string_cache_misses", (getter)SdBus_string_cache_misses_getter, NULL, PyDoc_STR("Number of decoded strings not found in string cache."), NULL},
+    {"string_cache_size", (getter)SdBus_string_cache_size_getter, (setter)SdBus_string_cache_size_setter,
+     PyDoc_STR("Number of entries in string cache. Zero disables cache."), NULL},
+    {"pending_calls", (getter)SdBus_pending_calls_getter, NULL, PyDoc_STR("Number of async method calls waiting for reply."), NULL},
+    {"cancelled_calls", (getter)SdBus_cancelled_calls_getter, NULL, PyDoc_STR("Number of async method calls cancelled before reply."), NULL},
+    {"drive_budget", (getter)SdBus_drive_budget_getter, (setter)SdBus_drive_budget_setter,
+     PyDoc_STR("Maximum number of messages dispatched by a single drive. Zero is unlimited."), NULL},
+    {"drive_time_budget_usec", (getter)SdBus_drive_time_budget_usec_getter, (setter)SdBus_drive_time_budget_usec_setter,
+     PyDoc_STR("Maximum time in microseconds spent by a single drive. Zero is unlimited."), NULL},
+    {"drive_prioritize_replies", (getter)SdBus_drive_prioritize_replies_getter, (setter)SdBus_drive_prioritize_replies_setter,
+     PyDoc_STR("Dispatch signals only after all received method replies."), NULL},
+    {"cork_sends", (getter)SdBus_cork_sends_getter, (setter)SdBus_cork_sends_setter,
+     PyDoc_STR("Send messages of async bus in one batch at the end of loop iteration."), NULL},
+    {"eager_dispatch", (getter)SdBus_eager_dispatch_getter, (setter)SdBus_eager_dispatch_setter,
+     PyDoc_STR("Start coroutine method handler tasks eagerly, saving a loop iteration. Needs Python 3.12 or newer."), NULL},
     {0},
 };
 
@@ -20,21 +20,34 @@
 */
 #include "sd_bus_internals.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+// Opening a bus connects and authenticates which can block
+#define SD_BUS_OPEN_WITHOUT_GIL(open_call)     \
+        ({                                     \
+                int open_return_value = 0;     \
+                Py_BEGIN_ALLOW_THREADS;        \
+                open_return_value = open_call; \
+                Py_END_ALLOW_THREADS;          \
+                open_return_value;             \
+        })
+
 static SdBusObject* sd_bus_py_open(PyObject* Py_UNUSED(self), PyObject* Py_UNUSED(ignored)) {
         SdBusObject* new_sd_bus = (SdBusObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBus_class));
-        CALL_SD_BUS_AND_CHECK(sd_bus_open(&(new_sd_bus->sd_bus_ref)));
+        CALL_SD_BUS_AND_CHECK(SD_BUS_OPEN_WITHOUT_GIL(sd_bus_open(&(new_sd_bus->sd_bus_ref))));
         return new_sd_bus;
 }
 
 static SdBusObject* sd_bus_py_open_user(PyObject* Py_UNUSED(self), PyObject* Py_UNUSED(ignored)) {
         SdBusObject* new_sd_bus = (SdBusObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBus_class));
-        CALL_SD_BUS_AND_CHECK(sd_bus_open_user(&(new_sd_bus->sd_bus_ref)));
+        CALL_SD_BUS_AND_CHECK(SD_BUS_OPEN_WITHOUT_GIL(sd_bus_open_user(&(new_sd_bus->sd_bus_ref))));
         return new_sd_bus;
 }
 
 static SdBusObject* sd_bus_py_open_system(PyObject* Py_UNUSED(self), PyObject* Py_UNUSED(ignored)) {
         SdBusObject* new_sd_bus = (SdBusObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBus_class));
-        CALL_SD_BUS_AND_CHECK(sd_bus_open_system(&(new_sd_bus->sd_bus_ref)));
+        CALL_SD_BUS_AND_CHECK(SD_BUS_OPEN_WITHOUT_GIL(sd_bus_open_system(&(new_sd_bus->sd_bus_ref))));
         return new_sd_bus;
 }
 
@@ -43,7 +56,7 @@ static SdBusObject* sd_bus_py_open_system_remote(PyObject* Py_UNUSED(self), PyOb
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "s", &remote_host_char_ptr, NULL));
 
         SdBusObject* new_sd_bus = (SdBusObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBus_class));
-        CALL_SD_BUS_AND_CHECK(sd_bus_open_system_remote(&(new_sd_bus->sd_bus_ref), remote_host_char_ptr));
+        CALL_SD_BUS_AND_CHECK(SD_BUS_OPEN_WITHOUT_GIL(sd_bus_open_system_remote(&(new_sd_bus->sd_bus_ref), remote_host_char_ptr)));
         return new_sd_bus;
 }
 
@@ -52,7 +65,7 @@ static SdBusObject* sd_bus_py_open_system_machine(PyObject* Py_UNUSED(self), PyO
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "s", &remote_host_char_ptr, NULL));
 
         SdBusObject* new_sd_bus = (SdBusObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBus_class));
-        CALL_SD_BUS_AND_CHECK(sd_bus_open_system_machine(&(new_sd_bus->sd_bus_ref), remote_host_char_ptr));
+        CALL_SD_BUS_AND_CHECK(SD_BUS_OPEN_WITHOUT_GIL(sd_bus_open_system_machine(&(new_sd_bus->sd_bus_ref), remote_host_char_ptr)));
         return new_sd_bus;
 }
 
@@ -62,7 +75,7 @@ static SdBusObject* sd_bus_py_open_user_machine(PyObject* Py_UNUSED(self), PyObj
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "s", &remote_host_char_ptr, NULL));
 
         SdBusObject* new_sd_bus = (SdBusObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBus_class));
-        CALL_SD_BUS_AND_CHECK(sd_bus_open_user_machine(&(new_sd_bus->sd_bus_ref), remote_host_char_ptr));
+        CALL_SD_BUS_AND_CHECK(SD_BUS_OPEN_WITHOUT_GIL(sd_bus_open_user_machine(&(new_sd_bus->sd_bus_ref), remote_host_char_ptr)));
         return new_sd_bus;
 #else
         PyErr_SetString(PyExc_NotImplementedError, "libsystemd < 248 does not support opening machine user bus");
@@ -70,6 +83,63 @@ static SdBusObject* sd_bus_py_open_user_machine(PyObject* Py_UNUSED(self), PyObj
 #endif
 }
 
+// Peer to peer connections
+//
+// Bus opened over a connected socket talks directly to the other
+// end without a broker in between. There is no Hello call and no
+// unique names so messages are routed only by object path. One end
+// must be a server which answers the authentication handshake.
+
+static int _sd_bus_start_peer(SdBusObject* new_sd_bus, int peer_fd, int is_server) {
+        CALL_SD_BUS_CHECK_RETURN_NEG1(sd_bus_new(&(new_sd_bus->sd_bus_ref)));
+
+        // Bus owns the descriptor and closes it on free
+        int bus_fd = fcntl(peer_fd, F_DUPFD_CLOEXEC, 3);
+        if (bus_fd < 0) {
+                PyErr_SetFromErrno(PyExc_OSError);
+                return -1;
+        }
+        int set_fd_return = sd_bus_set_fd(new_sd_bus->sd_bus_ref, bus_fd, bus_fd);
+        if (set_fd_return < 0) {
+                close(bus_fd);
+                CALL_SD_BUS_CHECK_RETURN_NEG1(set_fd_return);
+        }
+
+        if (is_server) {
+                sd_id128_t server_id;
+                CALL_SD_BUS_CHECK_RETURN_NEG1(sd_id128_randomize(&server_id));
+                CALL_SD_BUS_CHECK_RETURN_NEG1(sd_bus_set_server(new_sd_bus->sd_bus_ref, 1, server_id));
+        }
+
+        CALL_SD_BUS_CHECK_RETURN_NEG1(SD_BUS_OPEN_WITHOUT_GIL(sd_bus_start(new_sd_bus->sd_bus_ref)));
+        return 0;
+}
+
+static SdBusObject* sd_bus_py_open_peer_fd(PyObject* Py_UNUSED(self), PyObject* args, PyObject* kwargs) {
+        int peer_fd = -1;
+        int is_server = 0;
+        static char* kwlist[] = {"", "server", NULL};
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTupleAndKeywords(args, kwargs, "i|$p", kwlist, &peer_fd, &is_server));
+
+        PyObject* new_sd_bus CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBus_class));
+        CALL_PYTHON_INT_CHECK(_sd_bus_start_peer((SdBusObject*)new_sd_bus, peer_fd, is_server));
+        Py_INCREF(new_sd_bus);
+        return (SdBusObject*)new_sd_bus;
+}
+
+static SdBusObject* sd_bus_py_open_peer_address(PyObject* Py_UNUSED(self), PyObject* args) {
+        const char* address_char_ptr = NULL;
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "s", &address_char_ptr, NULL));
+
+        PyObject* new_sd_bus CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBus_class));
+        sd_bus** sd_bus_ref_ptr = &(((SdBusObject*)new_sd_bus)->sd_bus_ref);
+        CALL_SD_BUS_AND_CHECK(sd_bus_new(sd_bus_ref_ptr));
+        CALL_SD_BUS_AND_CHECK(sd_bus_set_address(*sd_bus_ref_ptr, address_char_ptr));
+        CALL_SD_BUS_AND_CHECK(SD_BUS_OPEN_WITHOUT_GIL(sd_bus_start(*sd_bus_ref_ptr)));
+        Py_INCREF(new_sd_bus);
+        return (SdBusObject*)new_sd_bus;
+}
+
 #ifndef Py_LIMITED_API
 static PyObject* encode_object_path(PyObject* Py_UNUSED(self), PyObject* const* args, Py_ssize_t nargs) {
         SD_BUS_PY_CHECK_ARGS_NUMBER(2);
@@ -273,6 +343,56 @@ static PyObject* is_object_path_valid(PyObject* Py_UNUSED(self), PyObject* args)
 #endif
 }
 
+static PyObject* _struct_signature_key(PyObject* signature_str) {
+        PyObject* plan_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusSignature_get_plan(signature_str));
+        const SdBusSignaturePlan* plan = _SdBusSignature_plan_from_capsule(plan_capsule);
+        if (plan->complete_types_count != 1 || plan->nodes[0].type != SD_BUS_TYPE_STRUCT) {
+                PyErr_Format(PyExc_ValueError, "Expected single struct signature, got %R", signature_str);
+                return NULL;
+        }
+        // Registry is keyed by struct contents as seen by the decoder
+        return PyUnicode_FromString(plan->nodes[0].contents);
+}
+
+#ifndef Py_LIMITED_API
+static PyObject* register_struct_type(PyObject* Py_UNUSED(self), PyObject* const* args, Py_ssize_t nargs) {
+        SD_BUS_PY_CHECK_ARGS_NUMBER(2);
+        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(0, PyUnicode_Check);
+        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(1, PyCallable_Check);
+        PyObject* signature_str = args[0];
+        PyObject* constructor = args[1];
+#else
+static PyObject* register_struct_type(PyObject* Py_UNUSED(self), PyObject* args) {
+        PyObject* signature_str = NULL;
+        PyObject* constructor = NULL;
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "UO", &signature_str, &constructor, NULL));
+        if (!PyCallable_Check(constructor)) {
+                PyErr_Format(PyExc_TypeError, "Expected callable struct type, got %R", constructor);
+                return NULL;
+        }
+#endif
+        PyObject* struct_key CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_struct_signature_key(signature_str));
+        CALL_PYTHON_INT_CHECK(PyDict_SetItem(struct_types_dict, struct_key, constructor));
+
+        Py_RETURN_NONE;
+}
+
+#ifndef Py_LIMITED_API
+static PyObject* unregister_struct_type(PyObject* Py_UNUSED(self), PyObject* const* args, Py_ssize_t nargs) {
+        SD_BUS_PY_CHECK_ARGS_NUMBER(1);
+        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(0, PyUnicode_Check);
+        PyObject* signature_str = args[0];
+#else
+static PyObject* unregister_struct_type(PyObject* Py_UNUSED(self), PyObject* args) {
+        PyObject* signature_str = NULL;
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "U", &signature_str, NULL));
+#endif
+        PyObject* struct_key CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_struct_signature_key(signature_str));
+        CALL_PYTHON_INT_CHECK(PyDict_DelItem(struct_types_dict, struct_key));
+
+        Py_RETURN_NONE;
+}
+
 PyMethodDef SdBusPyInternal_methods[] = {
     {"sd_bus_open", (PyCFunction)sd_bus_py_open, METH_NOARGS, PyDoc_STR("Open dbus connection. Session bus running as user or system bus as daemon.")},
     {"sd_bus_open_user", (PyCFunction)sd_bus_py_open_user, METH_NOARGS, PyDoc_STR("Open user session dbus.")},
@@ -280,6 +400,10 @@ PyMethodDef SdBusPyInternal_methods[] = {
     {"sd_bus_open_system_remote", (PyCFunction)sd_bus_py_open_system_remote, METH_VARARGS, PyDoc_STR("Open remote system bus over SSH.")},
     {"sd_bus_open_user_machine", (PyCFunction)sd_bus_py_open_user_machine, METH_VARARGS, PyDoc_STR("Open system bus in systemd-nspawn container.")},
     {"sd_bus_open_system_machine", (PyCFunction)sd_bus_py_open_system_machine, METH_VARARGS, PyDoc_STR("Open user bus in systemd-nspawn container.")},
+    {"sd_bus_open_peer_fd", (PyCFunction)(void (*)(void))sd_bus_py_open_peer_fd, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR("Open direct peer to peer connection over connected socket.")},
+    {"sd_bus_open_peer_address", (PyCFunction)sd_bus_py_open_peer_address, METH_VARARGS,
+     PyDoc_STR("Open direct peer to peer connection to D-Bus address.")},
     {"encode_object_path", (SD_BUS_PY_FUNC_TYPE)encode_object_path, SD_BUS_PY_METH,
      PyDoc_STR("Encode object path with object path prefix and arbitrary string.")},
     {"decode_object_path", (SD_BUS_PY_FUNC_TYPE)decode_object_path, SD_BUS_PY_METH,
@@ -290,5 +414,8 @@ PyMethodDef SdBusPyInternal_methods[] = {
     {"is_service_name_valid", (SD_BUS_PY_FUNC_TYPE)is_service_name_valid, SD_BUS_PY_METH, PyDoc_STR("Is the string valid service name?")},
     {"is_member_name_valid", (SD_BUS_PY_FUNC_TYPE)is_member_name_valid, SD_BUS_PY_METH, PyDoc_STR("Is the string valid member name?")},
     {"is_object_path_valid", (SD_BUS_PY_FUNC_TYPE)is_object_path_valid, SD_BUS_PY_METH, PyDoc_STR("Is the string valid object path?")},
+    {"register_struct_type", (SD_BUS_PY_FUNC_TYPE)register_struct_type, SD_BUS_PY_METH,
+     PyDoc_STR("Decode structs of the signature by calling the type with struct members.")},
+    {"unregister_struct_type", (SD_BUS_PY_FUNC_TYPE)unregister_struct_type, SD_BUS_PY_METH, PyDoc_STR("Decode structs of the signature as tuples again.")},
     {NULL, NULL, 0, NULL},
 };
@@ -29,22 +29,53 @@ static int SdBusInterface_init(SdBusInterfaceObject* self, PyObject* Py_UNUSED(a
         self->property_list = CALL_PYTHON_CHECK_RETURN_NEG1(PyList_New((Py_ssize_t)0));
         self->property_get_dict = CALL_PYTHON_CHECK_RETURN_NEG1(PyDict_New());
         self->property_set_dict = CALL_PYTHON_CHECK_RETURN_NEG1(PyDict_New());
+        self->native_property_dict = CALL_PYTHON_CHECK_RETURN_NEG1(PyDict_New());
         self->signal_list = CALL_PYTHON_CHECK_RETURN_NEG1(PyList_New((Py_ssize_t)0));
+        self->properties_snapshot = NULL;
+        self->snapshot_slot = (SdBusSlotObject*)CALL_PYTHON_CHECK_RETURN_NEG1(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusSlot_class));
+        self->interface_name = NULL;
         self->vtable = NULL;
+        self->members = NULL;
+        self->members_count = 0;
         return 0;
 }
 
+static void _SdBusInterface_clear_native_value(SdBusInterfaceMember* member) {
+        switch (member->native_type) {
+                case 's':
+                case 'o':
+                case 'g':
+                        free(member->native_value.s);
+                        member->native_value.s = NULL;
+                        break;
+                default:
+                        break;
+        }
+}
+
 static void SdBusInterface_dealloc(SdBusInterfaceObject* self) {
         Py_XDECREF(self->interface_slot);
+        Py_XDECREF(self->snapshot_slot);
+        Py_XDECREF(self->properties_snapshot);
+        free(self->interface_name);
         Py_XDECREF(self->method_list);
         Py_XDECREF(self->method_dict);
         Py_XDECREF(self->property_list);
         Py_XDECREF(self->property_get_dict);
         Py_XDECREF(self->property_set_dict);
+        Py_XDECREF(self->native_property_dict);
         Py_XDECREF(self->signal_list);
         if (self->vtable) {
                 free(self->vtable);
         }
+        for (Py_ssize_t i = 0; i < self->members_count; ++i) {
+                Py_XDECREF(self->members[i].callback);
+                Py_XDECREF(self->members[i].setter);
+                Py_XDECREF(self->members[i].property_name);
+                Py_XDECREF(self->members[i].signature_plan);
+                _SdBusInterface_clear_native_value(&self->members[i]);
+        }
+        free(self->members);
 
         SD_BUS_DEALLOC_TAIL;
 }
@@ -81,7 +112,8 @@ static PyObject* SdBusInterface_add_property(SdBusInterfaceObject* self, PyObjec
 #endif
         PyObject* name_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(name);
         PyObject* signature_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(signature);
-        PyObject* new_tuple CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyTuple_Pack(4, name_bytes, signature_bytes, flags, setter));
+        // Name, signature, flags, setter, is native
+        PyObject* new_tuple CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyTuple_Pack(5, name_bytes, signature_bytes, flags, setter, Py_False));
 
         CALL_PYTHON_INT_CHECK(PyList_Append(self->property_list, new_tuple));
         CALL_PYTHON_INT_CHECK(PyDict_SetItem(self->property_get_dict, name_bytes, getter));
@@ -90,6 +122,190 @@ static PyObject* SdBusInterface_add_property(SdBusInterfaceObject* self, PyObjec
         Py_RETURN_NONE;
 }
 
+// Native properties
+//
+// Value of a native property is stored in its member record and the
+// vtable entry has no getter. sd-bus reads the value from the record
+// itself so Get and GetAll calls never enter Python. Only single basic
+// types are supported. Native properties can't be set over D-Bus.
+
+static PyObject* _SdBusInterface_set_native_value(SdBusInterfaceMember* member, PyObject* new_value) {
+        char native_type = member->native_type;
+        switch (native_type) {
+                case 'y':
+                case 'q':
+                case 'u':
+                case 't': {
+                        unsigned long long the_ulong_long = PyLong_AsUnsignedLongLong(new_value);
+                        PYTHON_ERR_OCCURED;
+                        unsigned long long max_value = native_type == 'y'   ? UINT8_MAX
+                                                       : native_type == 'q' ? UINT16_MAX
+                                                       : native_type == 'u' ? UINT32_MAX
+                                                                            : UINT64_MAX;
+                        if (max_value < the_ulong_long) {
+                                PyErr_Format(PyExc_OverflowError, "Cannot convert int to '%c' type, overflow. '%c' is max %llu", native_type, native_type,
+                                             max_value);
+                                return NULL;
+                        }
+                        if (native_type == 'y') {
+                                member->native_value.y = (uint8_t)the_ulong_long;
+                        } else if (native_type == 'q') {
+                                member->native_value.q = (uint16_t)the_ulong_long;
+                        } else if (native_type == 'u') {
+                                member->native_value.u = (uint32_t)the_ulong_long;
+                        } else {
+                                member->native_value.t = the_ulong_long;
+                        }
+                        break;
+                }
+                case 'n':
+                case 'i':
+                case 'x': {
+                        long long the_long_long = PyLong_AsLongLong(new_value);
+                        PYTHON_ERR_OCCURED;
+                        long long max_value = native_type == 'n' ? INT16_MAX : native_type == 'i' ? INT32_MAX : INT64_MAX;
+                        long long min_value = native_type == 'n' ? INT16_MIN : native_type == 'i' ? INT32_MIN : INT64_MIN;
+                        if (max_value < the_long_long || min_value > the_long_long) {
+                                PyErr_Format(PyExc_OverflowError, "Cannot convert int to '%c' type. '%c' range is %lli to %lli", native_type, native_type,
+                                             min_value, max_value);
+                                return NULL;
+                        }
+                        if (native_type == 'n') {
+                                member->native_value.n = (int16_t)the_long_long;
+                        } else if (native_type == 'i') {
+                                member->native_value.i = (int32_t)the_long_long;
+                        } else {
+                                member->native_value.x = the_long_long;
+                        }
+                        break;
+                }
+                case 'b': {
+                        if (!PyBool_Check(new_value)) {
+                                PyErr_Format(PyExc_TypeError, "Native property expected bool got %R", new_value);
+                                return NULL;
+                        }
+                        member->native_value.b = (new_value == Py_True);
+                        break;
+                }
+                case 'd': {
+                        if (!PyFloat_Check(new_value)) {
+                                PyErr_Format(PyExc_TypeError, "Native property expected double got %R", new_value);
+                                return NULL;
+                        }
+                        member->native_value.d = PyFloat_AsDouble(new_value);
+                        break;
+                }
+                case 'o':
+                case 'g':
+                case 's': {
+                        if (!PyUnicode_Check(new_value)) {
+                                PyErr_Format(PyExc_TypeError, "Native property expected str got %R", new_value);
+                                return NULL;
+                        }
+#ifndef Py_LIMITED_API
+                        const char* new_char_ptr = SD_BUS_PY_UNICODE_AS_CHAR_PTR(new_value);
+#else
+                        PyObject* new_value_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(new_value);
+                        const char* new_char_ptr = SD_BUS_PY_BYTES_AS_CHAR_PTR(new_value_bytes);
+#endif
+                        if (native_type == 'o' && !sd_bus_object_path_is_valid(new_char_ptr)) {
+                                PyErr_Format(PyExc_ValueError, "Invalid object path %R", new_value);
+                                return NULL;
+                        }
+                        char* new_string = strdup(new_char_ptr);
+                        if (new_string == NULL) {
+                                return PyErr_NoMemory();
+                        }
+                        free(member->native_value.s);
+                        member->native_value.s = new_string;
+                        break;
+                }
+                default:
+                        PyErr_Format(PyExc_ValueError, "Unknown native property type: %c", (int)native_type);
+                        return NULL;
+        }
+        Py_RETURN_NONE;
+}
+
+#ifndef Py_LIMITED_API
+static PyObject* SdBusInterface_add_native_property(SdBusInterfaceObject* self, PyObject* const* args, Py_ssize_t nargs) {
+        // Arguments
+        // Name, Signature, Initial value, Flags
+        SD_BUS_PY_CHECK_ARGS_NUMBER(4);
+        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(0, PyUnicode_Check);
+        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(1, PyUnicode_Check);
+        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(3, PyLong_Check);
+
+        PyObject* name = args[0];
+        PyObject* signature = args[1];
+        PyObject* initial_value = args[2];
+        PyObject* flags = args[3];
+#else
+static PyObject* SdBusInterface_add_native_property(SdBusInterfaceObject* self, PyObject* args) {
+        PyObject* name = NULL;
+        PyObject* signature = NULL;
+        PyObject* initial_value = NULL;
+        PyObject* flags = NULL;
+
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "OOOO", &name, &signature, &initial_value, &flags, NULL));
+#endif
+        PyObject* name_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(name);
+        PyObject* signature_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(signature);
+
+        const char* signature_char_ptr = SD_BUS_PY_BYTES_AS_CHAR_PTR(signature_bytes);
+        if (strlen(signature_char_ptr) != 1 || strchr("ybnqiuxtdsog", signature_char_ptr[0]) == NULL) {
+                PyErr_Format(PyExc_ValueError, "Native property must have a single basic type signature, got %R", signature);
+                return NULL;
+        }
+
+        // Check the initial value before it is stored
+        SdBusInterfaceMember test_member = {.native_type = signature_char_ptr[0]};
+        CALL_PYTHON_EXPECT_NONE(_SdBusInterface_set_native_value(&test_member, initial_value));
+        _SdBusInterface_clear_native_value(&test_member);
+
+        PyObject* new_tuple CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyTuple_Pack(5, name_bytes, signature_bytes, flags, Py_None, Py_True));
+
+        CALL_PYTHON_INT_CHECK(PyList_Append(self->property_list, new_tuple));
+        // Initial value is kept in place of the getter until vtable is created
+        CALL_PYTHON_INT_CHECK(PyDict_SetItem(self->property_get_dict, name_bytes, initial_value));
+        CALL_PYTHON_INT_CHECK(PyDict_SetItem(self->native_property_dict, name, Py_None));
+
+        Py_RETURN_NONE;
+}
+
+#ifndef Py_LIMITED_API
+static PyObject* SdBusInterface_set_native_property(SdBusInterfaceObject* self, PyObject* const* args, Py_ssize_t nargs) {
+        SD_BUS_PY_CHECK_ARGS_NUMBER(2);
+        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(0, PyUnicode_Check);
+
+        PyObject* name = args[0];
+        PyObject* new_value = args[1];
+#else
+static PyObject* SdBusInterface_set_native_property(SdBusInterfaceObject* self, PyObject* args) {
+        PyObject* name = NULL;
+        PyObject* new_value = NULL;
+
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "OO", &name, &new_value, NULL));
+#endif
+        PyObject* member_index_object = PyDict_GetItem(self->native_property_dict, name);
+        if (member_index_object == NULL) {
+                PyErr_Format(PyExc_KeyError, "No native property %R", name);
+                return NULL;
+        }
+
+        if (member_index_object == Py_None) {
+                // Vtable is not created yet. Replace the initial value
+                // which will be checked once the vtable is created.
+                PyObject* name_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(name);
+                CALL_PYTHON_INT_CHECK(PyDict_SetItem(self->property_get_dict, name_bytes, new_value));
+                Py_RETURN_NONE;
+        }
+
+        Py_ssize_t member_index = PyLong_AsSsize_t(member_index_object);
+        PYTHON_ERR_OCCURED;
+        return _SdBusInterface_set_native_value(&self->members[member_index], new_value);
+}
+
 #ifndef Py_LIMITED_API
 static PyObject* SdBusInterface_add_method(SdBusInterfaceObject* self, PyObject* const* args, Py_ssize_t nargs) {
         // Arguments
@@ -206,6 +422,29 @@ static int _SdBusInterface_property_set_callback(sd_bus* bus,
                                                  void* userdata,
                                                  sd_bus_error* ret_error);
 
+// Member dispatch
+//
+// Every method and property has a member record with the resolved
+// callbacks. Records array is passed to sd-bus as the vtable userdata
+// and every vtable entry offset points to its own record, so the
+// callbacks get the record directly without any lookups.
+
+static int _SdBusInterface_set_member(SdBusInterfaceObject* self, Py_ssize_t member_index, PyObject* callback, PyObject* setter) {
+        SdBusInterfaceMember* member = &self->members[member_index];
+        Py_INCREF(callback);
+        member->callback = callback;
+        if (setter != Py_None) {
+                Py_INCREF(setter);
+                member->setter = setter;
+        }
+        self->members_count = member_index + 1;
+
+        PyObject* is_coroutine_test_object CLEANUP_PY_OBJECT =
+            CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_CallFunctionObjArgs(is_coroutine_function, callback, NULL));
+        member->is_coroutine = PyObject_IsTrue(is_coroutine_test_object);
+        return member->is_coroutine < 0 ? -1 : 0;
+}
+
 static PyObject* SdBusInterface_create_vtable(SdBusInterfaceObject* self, PyObject* const* Py_UNUSED(args)) {
         if (self->vtable) {
                 Py_RETURN_NONE;
@@ -215,6 +454,11 @@ static PyObject* SdBusInterface_create_vtable(SdBusInterfaceObject* self, PyObje
         Py_ssize_t num_of_properties = PyList_Size(self->property_list);
         Py_ssize_t num_of_signals = PyList_Size(self->signal_list);
 
+        self->members = calloc(num_of_methods + num_of_properties + 1, sizeof(SdBusInterfaceMember));
+        if (self->members == NULL) {
+                return PyErr_NoMemory();
+        }
+
         self->vtable = calloc(num_of_signals + num_of_properties + num_of_methods + 2, sizeof(sd_bus_vtable));
         if (self->vtable == NULL) {
                 return PyErr_NoMemory();
@@ -246,8 +490,12 @@ static PyObject* SdBusInterface_create_vtable(SdBusInterfaceObject* self, PyObje
                         return NULL;
                 }
 
-                sd_bus_vtable temp_vtable = SD_BUS_METHOD_WITH_NAMES_OFFSET(method_name_char_ptr, input_signature_char_ptr, argument_names_char_ptr,
-                                                                            result_signature_char_ptr, , _SdBusInterface_callback, 0, flags_long);
+                PyObject* callback_object = CALL_PYTHON_AND_CHECK(PyDict_GetItem(self->method_dict, method_name_object));
+                CALL_PYTHON_INT_CHECK(_SdBusInterface_set_member(self, i, callback_object, Py_None));
+
+                sd_bus_vtable temp_vtable =
+                    SD_BUS_METHOD_WITH_NAMES_OFFSET(method_name_char_ptr, input_signature_char_ptr, argument_names_char_ptr, result_signature_char_ptr, ,
+                                                    _SdBusInterface_callback, i * sizeof(SdBusInterfaceMember), flags_long);
                 self->vtable[current_index] = temp_vtable;
         }
 
@@ -261,6 +509,7 @@ static PyObject* SdBusInterface_create_vtable(SdBusInterfaceObject* self, PyObje
                 PyObject* property_signature_str = SD_BUS_PY_TUPLE_GET_ITEM(property_tuple, 1);
                 PyObject* property_flags = SD_BUS_PY_TUPLE_GET_ITEM(property_tuple, 2);
                 PyObject* setter_or_none = SD_BUS_PY_TUPLE_GET_ITEM(property_tuple, 3);
+                PyObject* is_native = SD_BUS_PY_TUPLE_GET_ITEM(property_tuple, 4);
 
                 const char* property_name_char_ptr = SD_BUS_PY_BYTES_AS_CHAR_PTR(property_name_str);
                 const char* property_signature_const_char = SD_BUS_PY_BYTES_AS_CHAR_PTR(property_signature_str);
@@ -270,11 +519,43 @@ static PyObject* SdBusInterface_create_vtable(SdBusInterfaceObject* self, PyObje
                         return NULL;
                 }
 
+                Py_ssize_t member_index = num_of_methods + i;
+                PyObject* getter_object = CALL_PYTHON_AND_CHECK(PyDict_GetItem(self->property_get_dict, property_name_str));
+                size_t member_offset = member_index * sizeof(SdBusInterfaceMember);
+
+                // Name and signature plan are used by properties snapshot
+                SdBusInterfaceMember* member = &self->members[member_index];
+                self->members_count = member_index + 1;
+                member->property_name = CALL_PYTHON_AND_CHECK(PyUnicode_FromString(property_name_char_ptr));
+                PyObject* property_signature_unicode CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyUnicode_FromString(property_signature_const_char));
+                member->signature_plan = CALL_PYTHON_AND_CHECK(_SdBusSignature_get_plan(property_signature_unicode));
+
+                if (is_native == Py_True) {
+                        member->native_type = property_signature_const_char[0];
+                        // Getter is the initial value for native properties
+                        CALL_PYTHON_EXPECT_NONE(_SdBusInterface_set_native_value(member, getter_object));
+
+                        PyObject* member_index_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyLong_FromSsize_t(member_index));
+                        CALL_PYTHON_INT_CHECK(PyDict_SetItem(self->native_property_dict, member->property_name, member_index_object));
+
+                        // No getter, sd-bus reads the value at the offset
+                        sd_bus_vtable temp_vtable = SD_BUS_PROPERTY(property_name_char_ptr,                                          // Name
+                                                                    property_signature_const_char,                                   // Signature
+                                                                    NULL,                                                            // Get
+                                                                    member_offset + offsetof(SdBusInterfaceMember, native_value),  // Offset
+                                                                    flags_long                                                       // Flags
+                        );
+                        self->vtable[current_index] = temp_vtable;
+                        continue;
+                }
+
+                CALL_PYTHON_INT_CHECK(_SdBusInterface_set_member(self, member_index, getter_object, setter_or_none));
+
                 if (setter_or_none == Py_None) {
                         sd_bus_vtable temp_vtable = SD_BUS_PROPERTY(property_name_char_ptr,                 // Name
                                                                     property_signature_const_char,          // Signature
                                                                     _SdBusInterface_property_get_callback,  // Get
-                                                                    0,                                      // Offset
+                                                                    member_offset,                          // Offset
                                                                     flags_long                              // Flags
                         );
                         self->vtable[current_index] = temp_vtable;
@@ -283,7 +564,7 @@ static PyObject* SdBusInterface_create_vtable(SdBusInterfaceObject* self, PyObje
                                                                              property_signature_const_char,          // Signature
                                                                              _SdBusInterface_property_get_callback,  // Get
                                                                              _SdBusInterface_property_set_callback,  // Set
-                                                                             0,                                      // Offset
+                                                                             member_offset,                          // Offset
                                                                              flags_long                              // Flags
                         );
                         self->vtable[current_index] = temp_vtable;
@@ -320,9 +601,32 @@ static PyObject* SdBusInterface_create_vtable(SdBusInterfaceObject* self, PyObje
         Py_RETURN_NONE;
 }
 
+static PyObject* SdBusInterface_set_properties_snapshot(SdBusInterfaceObject* self, PyObject* new_snapshot) {
+        if (self->vtable != NULL) {
+                PyErr_SetString(PyExc_RuntimeError, "Interface already exported");
+                return NULL;
+        }
+        if (!_check_callable_or_none(new_snapshot)) {
+                PyErr_Format(PyExc_TypeError, "Expected callable or None, got %R", new_snapshot);
+                return NULL;
+        }
+
+        Py_CLEAR(self->properties_snapshot);
+        if (new_snapshot != Py_None) {
+                Py_INCREF(new_snapshot);
+                self->properties_snapshot = new_snapshot;
+        }
+        Py_RETURN_NONE;
+}
+
 static PyMethodDef SdBusInterface_methods[] = {
     {"add_method", (SD_BUS_PY_FUNC_TYPE)SdBusInterface_add_method, SD_BUS_PY_METH, PyDoc_STR("Add method to the D-Bus interface.")},
     {"add_property", (SD_BUS_PY_FUNC_TYPE)SdBusInterface_add_property, SD_BUS_PY_METH, PyDoc_STR("Add property to the D-Bus interface.")},
+    {"add_native_property", (SD_BUS_PY_FUNC_TYPE)SdBusInterface_add_native_property, SD_BUS_PY_METH,
+     PyDoc_STR("Add property which value is stored and served by sd-bus.")},
+    {"set_native_property", (SD_BUS_PY_FUNC_TYPE)SdBusInterface_set_native_property, SD_BUS_PY_METH, PyDoc_STR("Update value of native property.")},
+    {"set_properties_snapshot", (PyCFunction)SdBusInterface_set_properties_snapshot, METH_O,
+     PyDoc_STR("Set callable that returns all properties values for GetAll call.")},
     {"add_signal", (SD_BUS_PY_FUNC_TYPE)SdBusInterface_add_signal, SD_BUS_PY_METH, PyDoc_STR("Add signal to the D-Bus interface.")},
     {"_create_vtable", (PyCFunction)SdBusInterface_create_vtable, METH_NOARGS, PyDoc_STR("Creates the vtable.")},
     {NULL, NULL, 0, NULL},
@@ -333,6 +637,7 @@ static PyMemberDef SdBusInterface_members[] = {{"method_list", T_OBJECT, offseto
                                                {"property_list", T_OBJECT, offsetof(SdBusInterfaceObject, property_list), READONLY, NULL},
                                                {"property_get_dict", T_OBJECT, offsetof(SdBusInterfaceObject, property_get_dict), READONLY, NULL},
                                                {"property_set_dict", T_OBJECT, offsetof(SdBusInterfaceObject, property_set_dict), READONLY, NULL},
+                                               {"native_property_dict", T_OBJECT, offsetof(SdBusInterfaceObject, native_property_dict), READONLY, NULL},
                                                {"signal_list", T_OBJECT, offsetof(SdBusInterfaceObject, signal_list), READONLY, NULL},
                                                {0}};
 
@@ -374,30 +679,50 @@ fail:
 
 #define METHOD_CALLBACK_ERROR_CHECK(py_function) CALL_PYTHON_FAIL_ACTION(py_function, return set_dbus_error_from_python_exception(ret_error))
 
-static int _SdBusInterface_callback(sd_bus_message* m, void* userdata, sd_bus_error* ret_error) {
-        // TODO: Better error handling
-        SdBusInterfaceObject* self = userdata;
-        // Get the member name from the message
-        const char* member_char_ptr = sd_bus_message_get_member(m);
-        PyObject* member_name_bytes CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(PyBytes_FromString(member_char_ptr));
-        PyObject* callback_object = METHOD_CALLBACK_ERROR_CHECK(PyDict_GetItem(self->method_dict, member_name_bytes));
+// Eager dispatch
+//
+// With eager_dispatch the task of a coroutine handler is created
+// with eager_start so the handler runs inline until it suspends.
+// Handler that does not suspend has replied before drive returns.
+// Only the loop iteration before the first step is saved, the task
+// and its context copy are still created. eager_dispatch can only be
+// enabled if asyncio tasks support eager_start (Python 3.12).
+
+static PyObject* _SdBusInterface_create_handler_task(PyObject* coroutine) {
+        PyObject* running_loop CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+        if (asyncio_eager_task_class == NULL || driving_bus == NULL || !driving_bus->eager_dispatch) {
+                return PyObject_CallMethodObjArgs(running_loop, create_task_str, coroutine, NULL);
+        }
 
-        PyObject* running_loop CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(PyObject_CallFunctionObjArgs(asyncio_get_running_loop, NULL));
+        PyObject* task_args CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyTuple_Pack(1, coroutine));
+        PyObject* task_kwargs CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(Py_BuildValue("{sOsO}", "loop", running_loop, "eager_start", Py_True));
+        return PyObject_Call(asyncio_eager_task_class, task_args, task_kwargs);
+}
+
+static PyObject* _SdBusInterface_call_with_message(PyObject* callback, PyObject* message) {
+#if !defined(Py_LIMITED_API) && PY_VERSION_HEX >= 0x03090000
+        // Spare slot in front lets bound methods prepend self in place
+        PyObject* callback_args[2] = {NULL, message};
+        return PyObject_Vectorcall(callback, callback_args + 1, 1 | PY_VECTORCALL_ARGUMENTS_OFFSET, NULL);
+#else
+        return PyObject_CallFunctionObjArgs(callback, message, NULL);
+#endif
+}
+
+static int _SdBusInterface_callback(sd_bus_message* m, void* userdata, sd_bus_error* ret_error) {
+        SdBusInterfaceMember* member = userdata;
 
         PyObject* new_message CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
 
         _SdBusMessage_set_messsage((SdBusMessageObject*)new_message, m);
 
-        PyObject* is_coroutine_test_object CLEANUP_PY_OBJECT =
-            METHOD_CALLBACK_ERROR_CHECK(PyObject_CallFunctionObjArgs(is_coroutine_function, callback_object, NULL));
-
-        if (Py_True == is_coroutine_test_object) {
+        if (member->is_coroutine) {
                 // Create coroutine
-                PyObject* coroutine_activated CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(PyObject_CallFunctionObjArgs(callback_object, new_message, NULL));
+                PyObject* coroutine_activated CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(_SdBusInterface_call_with_message(member->callback, new_message));
 
-                Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(PyObject_CallMethodObjArgs(running_loop, create_task_str, coroutine_activated, NULL)));
+                Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(_SdBusInterface_create_handler_task(coroutine_activated)));
         } else {
-                Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(PyObject_CallFunctionObjArgs(callback_object, new_message, NULL)));
+                Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(_SdBusInterface_call_with_message(member->callback, new_message)));
         }
 
         sd_bus_error_set(ret_error, NULL, NULL);
@@ -408,40 +733,149 @@ static int _SdBusInterface_callback(sd_bus_message* m, void* userdata, sd_bus_er
 static int _SdBusInterface_property_get_callback(sd_bus* Py_UNUSED(bus),
                                                  const char* Py_UNUSED(path),
                                                  const char* Py_UNUSED(interface),
-                                                 const char* property,
+                                                 const char* Py_UNUSED(property),
                                                  sd_bus_message* reply,
                                                  void* userdata,
                                                  sd_bus_error* ret_error) {
-        SdBusInterfaceObject* self = userdata;
-        PyObject* property_name_bytes CLEANUP_PY_OBJECT = NULL;
-        PyObject* get_call = NULL;
-        PyObject* new_message CLEANUP_PY_OBJECT = NULL;
-
-        property_name_bytes = METHOD_CALLBACK_ERROR_CHECK(PyBytes_FromString(property));
-        get_call = METHOD_CALLBACK_ERROR_CHECK(PyDict_GetItem(self->property_get_dict, property_name_bytes));
+        SdBusInterfaceMember* member = userdata;
 
-        new_message = METHOD_CALLBACK_ERROR_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
+        PyObject* new_message CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
         _SdBusMessage_set_messsage((SdBusMessageObject*)new_message, reply);
 
-        Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(PyObject_CallFunctionObjArgs(get_call, new_message, NULL)));
+        Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(_SdBusInterface_call_with_message(member->callback, new_message)));
         return 0;
 }
 
 static int _SdBusInterface_property_set_callback(sd_bus* Py_UNUSED(bus),
                                                  const char* Py_UNUSED(path),
                                                  const char* Py_UNUSED(interface),
-                                                 const char* property,
+                                                 const char* Py_UNUSED(property),
                                                  sd_bus_message* value,
                                                  void* userdata,
                                                  sd_bus_error* ret_error) {
-        SdBusInterfaceObject* self = userdata;
-        PyObject* property_name_bytes CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(PyBytes_FromString(property));
-
-        PyObject* set_call = METHOD_CALLBACK_ERROR_CHECK(PyDict_GetItem(self->property_set_dict, property_name_bytes));
+        SdBusInterfaceMember* member = userdata;
 
         PyObject* new_message CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
         _SdBusMessage_set_messsage((SdBusMessageObject*)new_message, value);
 
-        Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(PyObject_CallFunctionObjArgs(set_call, new_message, NULL)));
+        Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(_SdBusInterface_call_with_message(member->setter, new_message)));
+        return 0;
+}
+
+// Properties snapshot
+//
+// sd-bus calls the property getter once per property to answer
+// GetAll. If the interface has a snapshot callable an object callback
+// is added at the same path. It runs before the vtables and answers
+// GetAll for this interface with values from a single snapshot call.
+// Native properties are still read from their member records.
+
+static PyObject* _SdBusInterface_append_native_value(sd_bus_message* message, SdBusInterfaceMember* member) {
+        switch (member->native_type) {
+                case 's':
+                case 'o':
+                case 'g': {
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, member->native_type, member->native_value.s));
+                        break;
+                }
+                default: {
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, member->native_type, &member->native_value));
+                        break;
+                }
+        }
+        Py_RETURN_NONE;
+}
+
+static PyObject* _SdBusInterface_append_snapshot(SdBusInterfaceObject* self, sd_bus_message* reply, PyObject* snapshot) {
+        if (!PyDict_Check(snapshot)) {
+                PyErr_Format(PyExc_TypeError, "Properties snapshot must be a dict, got %R", snapshot);
+                return NULL;
+        }
+
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(reply, SD_BUS_TYPE_ARRAY, "{sv}"));
+        for (Py_ssize_t i = 0; i < self->members_count; ++i) {
+                SdBusInterfaceMember* member = &self->members[i];
+                if (member->property_name == NULL) {
+                        continue;
+                }
+                // Vtable starts with a start entry followed by members
+                const sd_bus_vtable* property_vtable = &self->vtable[i + 1];
+                if (property_vtable->flags & (SD_BUS_VTABLE_HIDDEN | SD_BUS_VTABLE_PROPERTY_EXPLICIT)) {
+                        continue;
+                }
+                if (property_vtable->flags & SD_BUS_VTABLE_SENSITIVE) {
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_sensitive(reply));
+                }
+
+                const SdBusSignaturePlan* signature_plan = _SdBusSignature_plan_from_capsule(member->signature_plan);
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(reply, SD_BUS_TYPE_DICT_ENTRY, "sv"));
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(reply, 's', property_vtable->x.property.member));
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(reply, SD_BUS_TYPE_VARIANT, signature_plan->signature));
+                if (member->native_type != '\0') {
+                        CALL_PYTHON_EXPECT_NONE(_SdBusInterface_append_native_value(reply, member));
+                } else {
+                        PyObject* property_value = PyDict_GetItemWithError(snapshot, member->property_name);
+                        if (property_value == NULL) {
+                                if (!PyErr_Occurred()) {
+                                        PyErr_Format(PyExc_KeyError, "Properties snapshot is missing %R", member->property_name);
+                                }
+                                return NULL;
+                        }
+                        CALL_PYTHON_EXPECT_NONE(_SdBusMessage_append_complete(reply, signature_plan->nodes, property_value));
+                }
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(reply));
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(reply));
+        }
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(reply));
+        Py_RETURN_NONE;
+}
+
+static int _SdBusInterface_snapshot_callback(sd_bus_message* m, void* userdata, sd_bus_error* ret_error) {
+        SdBusInterfaceObject* self = userdata;
+
+        if (!sd_bus_message_is_method_call(m, "org.freedesktop.DBus.Properties", "GetAll")) {
+                return 0;
+        }
+
+        const char* interface_name = NULL;
+        int read_result = sd_bus_message_read_basic(m, 's', &interface_name);
+        // Other interfaces are left for sd-bus and other callbacks
+        sd_bus_message_rewind(m, 1);
+        if (read_result <= 0 || strcmp(interface_name, self->interface_name) != 0) {
+                return 0;
+        }
+        if (!sd_bus_message_get_expect_reply(m)) {
+                return 1;
+        }
+
+        PyObject* snapshot CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(PyObject_CallFunctionObjArgs(self->properties_snapshot, NULL));
+
+        sd_bus_message* reply __attribute__((cleanup(sd_bus_message_unrefp))) = NULL;
+        int new_reply_result = sd_bus_message_new_method_return(m, &reply);
+        if (new_reply_result < 0) {
+                return new_reply_result;
+        }
+        Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(_SdBusInterface_append_snapshot(self, reply, snapshot)));
+
+        // Sent like SdBusMessage.send so the reply respects the cork
+        PyObject* reply_message CLEANUP_PY_OBJECT = METHOD_CALLBACK_ERROR_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
+        _SdBusMessage_set_messsage((SdBusMessageObject*)reply_message, reply);
+        Py_XDECREF(METHOD_CALLBACK_ERROR_CHECK(_SdBus_send_message((SdBusMessageObject*)reply_message)));
+        return 1;
+}
+
+int _SdBusInterface_add_snapshot_handler(SdBusInterfaceObject* self, sd_bus* bus, const char* path, const char* interface_name) {
+        if (self->properties_snapshot == NULL) {
+                return 0;
+        }
+
+        free(self->interface_name);
+        self->interface_name = strdup(interface_name);
+        if (self->interface_name == NULL) {
+                PyErr_NoMemory();
+                return -1;
+        }
+
+        CALL_SD_BUS_CHECK_RETURN_NEG1(sd_bus_add_object(bus, &self->snapshot_slot->slot_ref, path, _SdBusInterface_snapshot_callback, self));
         return 0;
 }
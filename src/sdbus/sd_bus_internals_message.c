@@ -24,7 +24,15 @@ void _SdBusMessage_set_messsage(SdBusMessageObject* self, sd_bus_message* new_me
         self->message_ref = sd_bus_message_ref(new_message);
 }
 
+static void _wait_message_bus(sd_bus_message* message) {
+        // Unreferencing or replying touches the bus the message belongs to
+        if (message != NULL) {
+                _SdBus_wait_blocking_call(sd_bus_message_get_bus(message));
+        }
+}
+
 static void SdBusMessage_dealloc(SdBusMessageObject* self) {
+        _wait_message_bus(self->message_ref);
         sd_bus_message_unref(self->message_ref);
 
         SD_BUS_DEALLOC_TAIL;
@@ -41,23 +49,9 @@ static PyObject* SdBusMessage_dump(SdBusMessageObject* self, PyObject* Py_UNUSED
         Py_RETURN_NONE;
 }
 
-typedef struct {
-        sd_bus_message* message;
-        const char* container_char_ptr;
-        size_t index;
-        size_t max_index;
-} _Parse_state;
-
-#define _CHECK_PARSER_NOT_NULL(parser)                                        \
-        if (parser_state->container_char_ptr[parser_state->index] == '\0') {  \
-                PyErr_SetString(PyExc_TypeError, "Data signature too short"); \
-                return NULL;                                                  \
-        }
+static PyObject* _parse_complete(PyObject* complete_obj, sd_bus_message* message, const SdBusSignatureNode* node);
 
-static PyObject* _parse_complete(PyObject* complete_obj, _Parse_state* parser_state);
-
-static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
-        char basic_type = parser_state->container_char_ptr[parser_state->index];
+static PyObject* _parse_basic(PyObject* basic_obj, sd_bus_message* message, char basic_type) {
         switch (basic_type) {
                 // Unsigned
                 case 'y': {
@@ -72,7 +66,7 @@ static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
                                 return NULL;
                         }
                         uint8_t byte_to_add = (uint8_t)the_ulong_long;
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &byte_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &byte_to_add));
                         break;
                 }
                 case 'q': {
@@ -87,7 +81,7 @@ static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
                                 return NULL;
                         }
                         uint16_t q_to_add = (uint16_t)the_ulong_long;
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &q_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &q_to_add));
                         break;
                 }
                 case 'u': {
@@ -102,14 +96,14 @@ static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
                                 return NULL;
                         }
                         uint32_t u_to_add = (uint32_t)the_ulong_long;
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &u_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &u_to_add));
                         break;
                 }
                 case 't': {
                         unsigned long long the_ulong_long = PyLong_AsUnsignedLongLong(basic_obj);
                         PYTHON_ERR_OCCURED;
                         uint64_t t_to_add = the_ulong_long;
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &t_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &t_to_add));
                         break;
                 }
                 // Signed
@@ -133,7 +127,7 @@ static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
                                 return NULL;
                         }
                         int16_t n_to_add = (int16_t)the_long_long;
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &n_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &n_to_add));
                         break;
                 }
                 case 'i': {
@@ -156,21 +150,21 @@ static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
                                 return NULL;
                         }
                         int32_t i_to_add = (int32_t)the_long_long;
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &i_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &i_to_add));
                         break;
                 }
                 case 'x': {
                         long long the_long_long = PyLong_AsLongLong(basic_obj);
                         PYTHON_ERR_OCCURED;
                         int64_t x_to_add = the_long_long;
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &x_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &x_to_add));
                         break;
                 }
                 case 'h': {
                         long long the_long_long = PyLong_AsLongLong(basic_obj);
                         PYTHON_ERR_OCCURED;
                         int h_to_add = (int)the_long_long;
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &h_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &h_to_add));
                         break;
                 }
                 case 'b': {
@@ -182,7 +176,7 @@ static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
                                 return NULL;
                         }
                         int bool_to_add = (basic_obj == Py_True);
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &bool_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &bool_to_add));
                         break;
                 }
                 case 'd': {
@@ -195,7 +189,7 @@ static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
                         }
                         double double_to_add = PyFloat_AsDouble(basic_obj);
                         PYTHON_ERR_OCCURED;
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, &double_to_add));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, &double_to_add));
                         break;
                 }
                 case 'o':
@@ -214,7 +208,7 @@ static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
                         PyObject* bytes_to_append CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(basic_obj);
                         const char* char_ptr_to_append = SD_BUS_PY_BYTES_AS_CHAR_PTR(bytes_to_append);
 #endif
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(parser_state->message, basic_type, char_ptr_to_append));
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, basic_type, char_ptr_to_append));
                         break;
                 }
                 default:
@@ -222,227 +216,222 @@ static PyObject* _parse_basic(PyObject* basic_obj, _Parse_state* parser_state) {
                         return NULL;
                         break;
         }
-        parser_state->index++;
         Py_RETURN_NONE;
 }
 
-static size_t _find_struct_end(const char* container_char_ptr, size_t current_index) {
-        // Initial state
-        // "...(...)..."
-        //      ^
-        int round_bracket_count = 1;
-        for (; container_char_ptr[current_index] != '\0'; ++current_index) {
-                char current_char = container_char_ptr[current_index];
-                if (current_char == ')') {
-                        --round_bracket_count;
-                }
+static PyObject* _parse_dict(PyObject* dict_object, sd_bus_message* message, const SdBusSignatureNode* dict_entry_node) {
+        // dict_entry_node
+        // "{sx}"
+        //  ^
+        if (!PyDict_Check(dict_object)) {
+                PyErr_Format(PyExc_TypeError, "Message append error, expected dict got %R", dict_object);
+                return NULL;
+        }
 
-                if (current_char == '(') {
-                        ++round_bracket_count;
-                }
+        const SdBusSignatureNode* key_node = dict_entry_node + 1;
+        const SdBusSignatureNode* value_node = key_node + key_node->size;
 
-                if (round_bracket_count == 0) {
-                        return current_index;
-                }
+        PyObject *key, *value;
+        Py_ssize_t pos = 0;
 
-                if (round_bracket_count < 0) {
-                        PyErr_SetString(PyExc_TypeError,
-                                        "Round braces count <0. Check "
-                                        "your signature.");
-                        return 0;
-                }
+        while (PyDict_Next(dict_object, &pos, &key, &value)) {
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(message, SD_BUS_TYPE_DICT_ENTRY, dict_entry_node->contents));
+                CALL_PYTHON_EXPECT_NONE(_parse_basic(key, message, key_node->type));
+                CALL_PYTHON_EXPECT_NONE(_parse_complete(value, message, value_node));
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(message));
         }
-        PyErr_SetString(PyExc_TypeError, "Reached the end of signature before the struct end");
-        return 0;
-}
-
-static size_t _find_dict_end(const char* container_char_ptr, size_t current_index) {
-        // Initial state
-        // "...a{..}..."
-        //      ^
-        int curly_bracket_count = 0;
-        for (; container_char_ptr[current_index] != '\0'; ++current_index) {
-                char current_char = container_char_ptr[current_index];
-                if (current_char == '}') {
-                        --curly_bracket_count;
-                }
-
-                if (current_char == '{') {
-                        ++curly_bracket_count;
-                }
 
-                if (curly_bracket_count == 0) {
-                        // "...a{..}..."
-                        //         ^
-                        return current_index;
-                }
+        Py_RETURN_NONE;
+}
 
-                if (curly_bracket_count < 0) {
-                        PyErr_SetString(PyExc_TypeError,
-                                        "Curly braces count <0. Check "
-                                        "your signature.");
+static int _is_fixed_array_type(char element_type) {
+        // Types that are stored continuously in arrays.
+        // 'h' is excluded because file descriptors are indexes in to
+        // message file descriptor list.
+        switch (element_type) {
+                case 'y':
+                case 'b':
+                case 'n':
+                case 'q':
+                case 'i':
+                case 'u':
+                case 'x':
+                case 't':
+                case 'd':
+                        return 1;
+                default:
                         return 0;
-                }
         }
-        PyErr_SetString(PyExc_TypeError, "Reached the end of signature before the struct end");
-        return 0;
 }
 
-static size_t _find_array_end(const char* container_char_ptr, size_t current_index) {
-        // Initial state
-        // "...as..."
-        //     ^
-        // "...a{sx}.."
-        //     ^
-        // "...a(as)..."
-        //     ^
+static size_t _fixed_type_size(char element_type) {
+        switch (element_type) {
+                case 'y':
+                        return sizeof(uint8_t);
+                case 'n':
+                case 'q':
+                        return sizeof(uint16_t);
+                case 'b':
+                case 'i':
+                case 'u':
+                        return sizeof(uint32_t);
+                case 'x':
+                case 't':
+                        return sizeof(uint64_t);
+                case 'd':
+                        return sizeof(double);
+                default:
+                        return 0;
+        }
+}
 
-        while (container_char_ptr[current_index] == 'a') {
-                current_index++;
+static int _buffer_format_matches(char element_type, const char* buffer_format, Py_ssize_t item_size) {
+        // Buffer format uses struct module syntax. Only native byte order
+        // single item formats can be copied without conversion.
+        switch (buffer_format[0]) {
+                case '@':
+                case '=':
+                        buffer_format++;
+                        break;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                case '<':
+#else
+                case '>':
+                case '!':
+#endif
+                        buffer_format++;
+                        break;
+                default:
+                        break;
         }
-        char current_char = container_char_ptr[current_index];
-        // "...as..."
-        //      ^
-        // "...a{sx}.."
-        //      ^
-        // "...a(as)..."
-        //      ^
-        if (current_char == '\0') {
-                PyErr_SetString(PyExc_TypeError,
-                                "Reached the end of signature before "
-                                "the array end");
+
+        char format_char = buffer_format[0];
+        if (format_char == '\0' || buffer_format[1] != '\0') {
                 return 0;
         }
-        if (current_char == '{') {
-                // "...a{sx}.."
-                //      ^
-                return _find_dict_end(container_char_ptr, current_index);
-        }
-        if (current_char == '(') {
-                current_index++;
-                // "...a(as)..."
-                //       ^
-                return _find_struct_end(container_char_ptr, current_index);
+
+        switch (element_type) {
+                case 'y': {
+                        return item_size == 1 && strchr("Bbc", format_char) != NULL;
+                }
+                case 'b': {
+                        // Booleans are converted from single bytes
+                        return item_size == 1 && format_char == '?';
+                }
+                case 'n':
+                case 'i':
+                case 'x': {
+                        return (size_t)item_size == _fixed_type_size(element_type) && strchr("bhilqn", format_char) != NULL;
+                }
+                case 'q':
+                case 'u':
+                case 't': {
+                        return (size_t)item_size == _fixed_type_size(element_type) && strchr("BHILQN", format_char) != NULL;
+                }
+                case 'd': {
+                        return item_size == sizeof(double) && format_char == 'd';
+                }
+                default:
+                        return 0;
         }
+}
 
-        return current_index;
+static PyObject* _append_array_data(sd_bus_message* message, char element_type, const void* data, size_t data_length) {
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_array(message, element_type, data, data_length));
+        Py_RETURN_NONE;
 }
 
-static const char* _subscript_char_ptr(const char* old_char_ptr, size_t start, size_t end) {
-        // "abc(def)..."
-        //  01234 |
-        //  0123456
-        // 6 - 4 = 2
-        // Actual string
-        // 'def\0'
-        // 3 string length without \0
-        // 4 string length with \0
-        size_t new_string_size = (end - start) + 1;
-        char* new_string = malloc(new_string_size + 1);
-        if (new_string == NULL) {
+static PyObject* _parse_fixed_array(PyObject* array_object, sd_bus_message* message, char element_type) {
+        // Any buffer such as array.array or memoryview with matching
+        // item format is copied in to message in one go.
+#ifndef Py_LIMITED_API
+        if (!PyObject_CheckBuffer(array_object)) {
+                PyErr_Format(PyExc_TypeError, "Message append error, expected array or buffer got %R", array_object);
                 return NULL;
         }
-        memcpy(new_string, old_char_ptr + start, new_string_size);
-        // Set last byte to NUL
-        new_string[new_string_size] = '\0';
-        return new_string;
-}
+        Py_buffer array_buffer CLEANUP_PY_BUFFER = {.obj = NULL};
+        CALL_PYTHON_INT_CHECK(PyObject_GetBuffer(array_object, &array_buffer, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS));
 
-static PyObject* _parse_dict(PyObject* dict_object, _Parse_state* parser_state) {
-        // parser_state->container_char_ptr
-        // "{sx}"
-        //  ^
-        if (!PyDict_Check(dict_object)) {
-                PyErr_Format(PyExc_TypeError, "Message append error, expected dict got %R", dict_object);
+        const char* buffer_format = array_buffer.format != NULL ? array_buffer.format : "B";
+        Py_ssize_t item_size = array_buffer.itemsize;
+        const void* buffer_data = array_buffer.buf;
+        size_t buffer_length = (size_t)array_buffer.len;
+#else
+        PyObject* array_view CLEANUP_PY_OBJECT = PyMemoryView_FromObject(array_object);
+        if (array_view == NULL) {
+                if (PyErr_ExceptionMatches(PyExc_TypeError)) {
+                        PyErr_Clear();
+                        PyErr_Format(PyExc_TypeError, "Message append error, expected array or buffer got %R", array_object);
+                }
+                return NULL;
+        }
+        PyObject* format_str CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString(array_view, "format"));
+        PyObject* format_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(format_str);
+        const char* buffer_format = SD_BUS_PY_BYTES_AS_CHAR_PTR(format_bytes);
+        PyObject* item_size_int CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_GetAttrString(array_view, "itemsize"));
+        Py_ssize_t item_size = PyLong_AsSsize_t(item_size_int);
+        PYTHON_ERR_OCCURED;
+        // Limited API has no access to buffers so copy them in to bytes
+        PyObject* buffer_bytes CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyObject_CallMethod(array_view, "tobytes", NULL));
+        const void* buffer_data = SD_BUS_PY_BYTES_AS_CHAR_PTR(buffer_bytes);
+        size_t buffer_length = (size_t)PyBytes_Size(buffer_bytes);
+#endif
+        if (!_buffer_format_matches(element_type, buffer_format, item_size)) {
+                PyErr_Format(PyExc_TypeError, "Buffer format '%s' with item size %zi can't be appended as 'a%c' array", buffer_format, item_size,
+                             (int)element_type);
                 return NULL;
         }
 
-        const char* dict_sig_char_ptr CLEANUP_STR_MALLOC = _subscript_char_ptr(parser_state->container_char_ptr, 1, parser_state->max_index - 2);
-        // "sx"
-        parser_state->container_char_ptr = dict_sig_char_ptr;  // This is OK because its cleanup from
-                                                               // outside
-        parser_state->max_index = strlen(dict_sig_char_ptr);
-
-        PyObject *key, *value;
-        Py_ssize_t pos = 0;
-
-        while (PyDict_Next(dict_object, &pos, &key, &value)) {
-                CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(parser_state->message, 'e', dict_sig_char_ptr));
-                parser_state->index = 0;
-                CALL_PYTHON_EXPECT_NONE(_parse_basic(key, parser_state));
-                CALL_PYTHON_EXPECT_NONE(_parse_complete(value, parser_state));
-                CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(parser_state->message));
+        if (element_type == 'b') {
+                // sd-bus does not allow bulk appending booleans
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(message, SD_BUS_TYPE_ARRAY, "b"));
+                for (size_t i = 0; i < buffer_length; ++i) {
+                        int bool_to_add = ((const uint8_t*)buffer_data)[i] != 0;
+                        CALL_SD_BUS_AND_CHECK(sd_bus_message_append_basic(message, 'b', &bool_to_add));
+                }
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(message));
+        } else {
+                CALL_PYTHON_EXPECT_NONE(_append_array_data(message, element_type, buffer_data, buffer_length));
         }
 
         Py_RETURN_NONE;
 }
 
-static PyObject* _parse_array(PyObject* array_object, _Parse_state* parser_state) {
-        // Initial state
-        // "...as..."
-        //     ^
-        // "...a{sx}.."
-        //     ^
-        // "...a(as)..."
-        //     ^
-        size_t array_end = _find_array_end(parser_state->container_char_ptr, parser_state->index);
-        if (array_end == 0) {
-                return NULL;
-        }
-        // Array end points to
-        // "...as..."
-        //      ^
-        // "...a{sx}.."
-        //         ^
-        // "...a(as)..."
-        //         ^
-        const char* array_sig_char_ptr CLEANUP_STR_MALLOC = _subscript_char_ptr(parser_state->container_char_ptr, parser_state->index + 1, array_end);
-        // array_sig_char_ptr
+static PyObject* _parse_array(PyObject* array_object, sd_bus_message* message, const SdBusSignatureNode* array_node) {
+        // array_node->contents
         // "...as..."
         //     "s"
         // "...a{sx}.."
         //     "{sx}"
         // "...a(as)..."
         //     "(as)"
-        _Parse_state array_parser = {
-            .message = parser_state->message,
-            .container_char_ptr = array_sig_char_ptr,
-            .index = 0,
-            .max_index = strlen(array_sig_char_ptr),
-        };
-        if (array_parser.container_char_ptr[0] == '{') {
-                CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(parser_state->message, 'a', array_sig_char_ptr));
-                CALL_PYTHON_EXPECT_NONE(_parse_dict(array_object, &array_parser));
-                CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(parser_state->message));
-        } else if (array_parser.container_char_ptr[0] == 'y') {
-                char* char_ptr_to_add = NULL;
-                ssize_t size_of_array = 0;
-                if (PyByteArray_Check(array_object)) {
-                        char_ptr_to_add = PyByteArray_AsString(array_object);
-                        if (char_ptr_to_add == NULL) {
-                                return NULL;
-                        }
-                        size_of_array = PyByteArray_Size(array_object);
-                        if (size_of_array == -1) {
-                                return NULL;
-                        }
-                } else if (PyBytes_Check(array_object)) {
-                        char_ptr_to_add = PyBytes_AsString(array_object);
-                        if (char_ptr_to_add == NULL) {
-                                return NULL;
-                        }
-                        size_of_array = PyBytes_Size(array_object);
-                        if (size_of_array == -1) {
-                                return NULL;
-                        }
-                } else {
-                        PyErr_Format(PyExc_TypeError,
-                                     "Expected bytes or byte "
-                                     "array, got %R",
-                                     array_object);
+        const SdBusSignatureNode* element_node = array_node + 1;
+        if (element_node->type == SD_BUS_TYPE_DICT_ENTRY) {
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(message, SD_BUS_TYPE_ARRAY, array_node->contents));
+                CALL_PYTHON_EXPECT_NONE(_parse_dict(array_object, message, element_node));
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(message));
+        } else if (element_node->type == 'y' && PyByteArray_Check(array_object)) {
+                char* char_ptr_to_add = PyByteArray_AsString(array_object);
+                if (char_ptr_to_add == NULL) {
                         return NULL;
                 }
-                CALL_SD_BUS_AND_CHECK(sd_bus_message_append_array(parser_state->message, 'y', char_ptr_to_add, (size_t)size_of_array));
+                ssize_t size_of_array = PyByteArray_Size(array_object);
+                if (size_of_array == -1) {
+                        return NULL;
+                }
+                CALL_PYTHON_EXPECT_NONE(_append_array_data(message, 'y', char_ptr_to_add, (size_t)size_of_array));
+        } else if (element_node->type == 'y' && PyBytes_Check(array_object)) {
+                char* char_ptr_to_add = PyBytes_AsString(array_object);
+                if (char_ptr_to_add == NULL) {
+                        return NULL;
+                }
+                ssize_t size_of_array = PyBytes_Size(array_object);
+                if (size_of_array == -1) {
+                        return NULL;
+                }
+                CALL_PYTHON_EXPECT_NONE(_append_array_data(message, 'y', char_ptr_to_add, (size_t)size_of_array));
+        } else if (element_node->type == 'y' || (_is_fixed_array_type(element_node->type) && !PyList_Check(array_object))) {
+                CALL_PYTHON_EXPECT_NONE(_parse_fixed_array(array_object, message, element_node->type));
         } else {
                 if (!PyList_Check(array_object)) {
                         PyErr_Format(PyExc_TypeError,
@@ -452,73 +441,40 @@ static PyObject* _parse_array(PyObject* array_object, _Parse_state* parser_state
                         return NULL;
                 }
 
-                // "...as..."
-                //     "s"
-                // "...aa{sx}.."
-                //     "a{sx}"
-                // "...a(as)..."
-                //     "(as)"
-                CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(parser_state->message, 'a', array_sig_char_ptr));
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(message, SD_BUS_TYPE_ARRAY, array_node->contents));
                 for (Py_ssize_t i = 0; i < SD_BUS_PY_LIST_GET_SIZE(array_object); ++i) {
-                        CALL_PYTHON_EXPECT_NONE(_parse_complete(SD_BUS_PY_LIST_GET_ITEM(array_object, i), &array_parser));
-                        array_parser.index = 0;
+                        CALL_PYTHON_EXPECT_NONE(_parse_complete(SD_BUS_PY_LIST_GET_ITEM(array_object, i), message, element_node));
                 }
-                CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(parser_state->message));
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(message));
         }
-        parser_state->index = array_end + 1;
-        // index points to
-        // "...as..."
-        //       ^
-        // "...a{sx}.."
-        //          ^
-        // "...a(as)..."
-        //          ^
         Py_RETURN_NONE;
 }
 
-static PyObject* _parse_struct(PyObject* tuple_object, _Parse_state* parser_state) {
-        // Initial state
+static PyObject* _parse_struct(PyObject* tuple_object, sd_bus_message* message, const SdBusSignatureNode* struct_node) {
+        // struct_node->contents
         // "...(...)..."
-        //     ^
+        //      "..."
         if (!PyTuple_Check(tuple_object)) {
                 PyErr_Format(PyExc_TypeError, "Message append error, expected tuple got %R", tuple_object);
                 return NULL;
         }
-        parser_state->index++;
-        // "...(...)..."
-        //      ^
-        size_t struct_end = _find_struct_end(parser_state->container_char_ptr, parser_state->index);
-
-        if (struct_end == 0) {
+        Py_ssize_t tuple_size = SD_BUS_PY_TUPLE_GET_SIZE(tuple_object);
+        if ((size_t)tuple_size != struct_node->members_count) {
+                PyErr_Format(PyExc_TypeError, "Expected tuple of %zu elements got %zi", struct_node->members_count, tuple_size);
                 return NULL;
         }
-        // Struct end points to
-        // "...(...)..."
-        //         ^
-        const char* struct_signature CLEANUP_STR_MALLOC = _subscript_char_ptr(parser_state->container_char_ptr, parser_state->index, struct_end - 1);
-        // struct_signature should be
-        // "...(...)..."
-        //     ^   ^
-        //     "..."
-        CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(parser_state->message, 'r', struct_signature));
-        for (Py_ssize_t i = 0; i < SD_BUS_PY_TUPLE_GET_SIZE(tuple_object); ++i) {
-                // Use original parser as there is not much reason to
-                // create new one
-                CALL_PYTHON_EXPECT_NONE(_parse_complete(SD_BUS_PY_TUPLE_GET_ITEM(tuple_object, i), parser_state));
+
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(message, SD_BUS_TYPE_STRUCT, struct_node->contents));
+        const SdBusSignatureNode* member_node = struct_node + 1;
+        for (Py_ssize_t i = 0; i < tuple_size; ++i) {
+                CALL_PYTHON_EXPECT_NONE(_parse_complete(SD_BUS_PY_TUPLE_GET_ITEM(tuple_object, i), message, member_node));
+                member_node += member_node->size;
         }
-        CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(parser_state->message));
-        // "...(...)..."
-        //         ^
-        parser_state->index++;
-        // Final state
-        // "...(...)..."
-        //          ^
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(message));
         Py_RETURN_NONE;
 }
 
-static PyObject* _parse_variant(PyObject* tuple_object, _Parse_state* parser_state) {
-        // Initial state "...v..."
-        //                   ^
+static PyObject* _parse_variant(PyObject* tuple_object, sd_bus_message* message) {
         if (!PyTuple_Check(tuple_object)) {
                 PyErr_Format(PyExc_TypeError, "Message append error, expected tuple got %R", tuple_object);
                 return NULL;
@@ -527,77 +483,42 @@ static PyObject* _parse_variant(PyObject* tuple_object, _Parse_state* parser_sta
                 PyErr_Format(PyExc_TypeError, "Expected tuple of only 2 elements got %zi", SD_BUS_PY_TUPLE_GET_SIZE(tuple_object));
                 return NULL;
         }
-        PyObject* variant_signature = SD_BUS_PY_TUPLE_GET_ITEM(tuple_object, 0);
-#ifndef Py_LIMITED_API
-        const char* variant_signature_char_ptr = SD_BUS_PY_UNICODE_AS_CHAR_PTR(variant_signature);
-#else
-        PyObject* variant_signature_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(variant_signature);
-        const char* variant_signature_char_ptr = SD_BUS_PY_BYTES_AS_CHAR_PTR(variant_signature_bytes);
-#endif
-        _Parse_state variant_parser = {
-            .message = parser_state->message,
-            .max_index = strlen(variant_signature_char_ptr),
-            .container_char_ptr = variant_signature_char_ptr,
-            .index = 0,
-        };
-
-        CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(parser_state->message, 'v', variant_signature_char_ptr));
-        PyObject* variant_body = SD_BUS_PY_TUPLE_GET_ITEM(tuple_object, 1);
-        CALL_PYTHON_EXPECT_NONE(_parse_complete(variant_body, &variant_parser));
-        CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(parser_state->message));
+        PyObject* variant_plan_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusSignature_get_plan(SD_BUS_PY_TUPLE_GET_ITEM(tuple_object, 0)));
+        const SdBusSignaturePlan* variant_plan = _SdBusSignature_plan_from_capsule(variant_plan_capsule);
+        if (variant_plan->complete_types_count != 1) {
+                PyErr_Format(PyExc_TypeError, "Variant signature must be a single complete type, got %R", SD_BUS_PY_TUPLE_GET_ITEM(tuple_object, 0));
+                return NULL;
+        }
 
-        // Final state "...v..."
-        //                  ^
-        parser_state->index++;
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_open_container(message, SD_BUS_TYPE_VARIANT, variant_plan->signature));
+        PyObject* variant_body = SD_BUS_PY_TUPLE_GET_ITEM(tuple_object, 1);
+        CALL_PYTHON_EXPECT_NONE(_parse_complete(variant_body, message, variant_plan->nodes));
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_close_container(message));
         Py_RETURN_NONE;
 }
 
-static PyObject* _parse_complete(PyObject* complete_obj, _Parse_state* parser_state) {
-        // Initial state "..."
-        //                ^
-        _CHECK_PARSER_NOT_NULL(parser_state);
-        char next_char = parser_state->container_char_ptr[parser_state->index];
-        switch (next_char) {
-                case '}': {
-                        PyErr_SetString(PyExc_TypeError,
-                                        "End of dict reached instead "
-                                        "of complete type");
-                        return NULL;
-                }
-                case ')': {
-                        PyErr_SetString(PyExc_TypeError,
-                                        "End of struct reached "
-                                        "instead of complete type");
-                        return NULL;
-                }
-                case '(': {
+static PyObject* _parse_complete(PyObject* complete_obj, sd_bus_message* message, const SdBusSignatureNode* node) {
+        switch (node->type) {
+                case SD_BUS_TYPE_STRUCT: {
                         // Struct == Tuple
-                        CALL_PYTHON_EXPECT_NONE(_parse_struct(complete_obj, parser_state));
-                        break;
-                }
-                case '{': {
-                        // Dict
-                        PyErr_SetString(PyExc_TypeError, "D-Bus dict can't be outside of array");
-                        return NULL;
-                        break;
+                        return _parse_struct(complete_obj, message, node);
                 }
-                case 'a': {
-                        // Array
-                        CALL_PYTHON_EXPECT_NONE(_parse_array(complete_obj, parser_state));
-                        break;
+                case SD_BUS_TYPE_ARRAY: {
+                        return _parse_array(complete_obj, message, node);
                 }
-                case 'v': {
+                case SD_BUS_TYPE_VARIANT: {
                         // Variant == (signature, data))
-                        CALL_PYTHON_EXPECT_NONE(_parse_variant(complete_obj, parser_state));
-                        break;
+                        return _parse_variant(complete_obj, message);
                 }
                 default: {
                         // Basic type
-                        CALL_PYTHON_EXPECT_NONE(_parse_basic(complete_obj, parser_state));
-                        break;
+                        return _parse_basic(complete_obj, message, node->type);
                 }
         }
-        Py_RETURN_NONE;
+}
+
+PyObject* _SdBusMessage_append_complete(sd_bus_message* message, const SdBusSignatureNode* node, PyObject* complete_obj) {
+        return _parse_complete(complete_obj, message, node);
 }
 
 #ifndef Py_LIMITED_API
@@ -608,17 +529,17 @@ static PyObject* SdBusMessage_append_data(SdBusMessageObject* self, PyObject* co
         }
         SD_BUS_PY_CHECK_ARG_CHECK_FUNC(0, PyUnicode_Check);
 
-        const char* signature_char_ptr = SD_BUS_PY_UNICODE_AS_CHAR_PTR(args[0]);
-
-        _Parse_state parser_state = {
-            .message = self->message_ref,
-            .container_char_ptr = signature_char_ptr,
-            .index = 0,
-            .max_index = strlen(signature_char_ptr),
-        };
+        PyObject* plan_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusSignature_get_plan(args[0]));
+        const SdBusSignaturePlan* plan = _SdBusSignature_plan_from_capsule(plan_capsule);
+        if ((size_t)(nargs - 1) > plan->complete_types_count) {
+                PyErr_SetString(PyExc_TypeError, "Data signature too short");
+                return NULL;
+        }
 
+        const SdBusSignatureNode* node = plan->nodes;
         for (Py_ssize_t i = 1; i < nargs; ++i) {
-                CALL_PYTHON_EXPECT_NONE(_parse_complete(args[i], &parser_state));
+                CALL_PYTHON_EXPECT_NONE(_parse_complete(args[i], self->message_ref, node));
+                node += node->size;
         }
 #else
 static PyObject* SdBusMessage_append_data(SdBusMessageObject* self, PyObject* args) {
@@ -627,19 +548,18 @@ static PyObject* SdBusMessage_append_data(SdBusMessageObject* self, PyObject* ar
                 PyErr_SetString(PyExc_TypeError, "Minimum 2 args required");
                 return NULL;
         }
-        PyObject* signature_str = PyTuple_GetItem(args, 0);
-        PyObject* signature_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(signature_str);
-        const char* signature_char_ptr = SD_BUS_PY_BYTES_AS_CHAR_PTR(signature_bytes);
 
-        _Parse_state parser_state = {
-            .message = self->message_ref,
-            .container_char_ptr = signature_char_ptr,
-            .index = 0,
-            .max_index = strlen(signature_char_ptr),
-        };
+        PyObject* plan_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusSignature_get_plan(PyTuple_GetItem(args, 0)));
+        const SdBusSignaturePlan* plan = _SdBusSignature_plan_from_capsule(plan_capsule);
+        if ((size_t)(num_args - 1) > plan->complete_types_count) {
+                PyErr_SetString(PyExc_TypeError, "Data signature too short");
+                return NULL;
+        }
 
+        const SdBusSignatureNode* node = plan->nodes;
         for (Py_ssize_t i = 1; i < num_args; ++i) {
-                CALL_PYTHON_EXPECT_NONE(_parse_complete(PyTuple_GetItem(args, i), &parser_state));
+                CALL_PYTHON_EXPECT_NONE(_parse_complete(PyTuple_GetItem(args, i), self->message_ref, node));
+                node += node->size;
         }
 #endif
         Py_RETURN_NONE;
@@ -690,12 +610,17 @@ static PyObject* SdBusMessage_enter_container(SdBusMessageObject* self, PyObject
 }
 
 static PyObject* SdBusMessage_exit_container(SdBusMessageObject* self, PyObject* Py_UNUSED(args)) {
+        // sd-bus refuses to exit partially read arrays
+        while (!CALL_SD_BUS_AND_CHECK(sd_bus_message_at_end(self->message_ref, 0))) {
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_skip(self->message_ref, NULL));
+        }
         CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(self->message_ref));
 
         Py_RETURN_NONE;
 }
 
 static SdBusMessageObject* SdBusMessage_create_reply(SdBusMessageObject* self, PyObject* Py_UNUSED(args)) {
+        _wait_message_bus(self->message_ref);
         SdBusMessageObject* new_reply_message CLEANUP_SD_BUS_MESSAGE =
             (SdBusMessageObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
 
@@ -706,40 +631,34 @@ static SdBusMessageObject* SdBusMessage_create_reply(SdBusMessageObject* self, P
 }
 
 static PyObject* SdBusMessage_send(SdBusMessageObject* self, PyObject* Py_UNUSED(args)) {
-        CALL_SD_BUS_AND_CHECK(sd_bus_send(NULL, self->message_ref, NULL));
-
-        Py_RETURN_NONE;
+        _wait_message_bus(self->message_ref);
+        return _SdBus_send_message(self);
 }
 
-static size_t _container_size(const char* container_sig) {
-        size_t container_size = 0;
-        size_t index = 0;
-
-        while ((container_sig[index]) != '\0') {
-                char current_char = container_sig[index];
-                index++;
-                if (current_char == 'a') {
-                        index = _find_array_end(container_sig, index);
-                        index++;
-                }
+typedef struct {
+        sd_bus_message* message;
+        SdBusMessageObject* message_object;
+        int arrays_as_buffer;
+        int bytes_as_memoryview;
+        PyObject* string_cache_capsule;
+        SdBusStringCache* string_cache;
+} _Iter_state;
+
+static void _cleanup_iter_state(_Iter_state* iter_state) {
+        Py_XDECREF(iter_state->string_cache_capsule);
+}
 
-                if (current_char == '(') {
-                        index = _find_struct_end(container_sig, index);
-                        index++;
-                }
+#define CLEANUP_ITER_STATE __attribute__((cleanup(_cleanup_iter_state)))
 
-                if (index == 0) {
-                        PyErr_SetString(PyExc_TypeError, "Failed to find container size");
-                        return 0;
-                }
+static PyObject* _iter_complete(_Iter_state* iter_state, const SdBusSignatureNode* node);
+static PyObject* _iter_struct(_Iter_state* iter_state, const SdBusSignatureNode* struct_node, PyObject* constructor);
 
-                container_size++;
-        }
-        return container_size;
+static PyObject* _iter_cached_string(_Iter_state* iter_state, char string_type) {
+        const char* new_string = NULL;
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_read_basic(iter_state->message, string_type, &new_string));
+        return _SdBusStringCache_get_string(iter_state->string_cache, new_string);
 }
 
-static PyObject* _iter_complete(_Parse_state* parser);
-
 static PyObject* _iter_basic(sd_bus_message* message, char basic_type) {
         switch (basic_type) {
                 case 'b': {
@@ -821,140 +740,451 @@ static PyObject* _iter_basic(sd_bus_message* message, char basic_type) {
         }
 }
 
-static PyObject* _iter_bytes_array(_Parse_state* parser) {
+#ifdef SD_BUS_PY_BUFFER_EXPORT
+static void SdBusMessageBuffer_dealloc(SdBusMessageBufferObject* self) {
+        Py_XDECREF(self->message_object);
+
+        SD_BUS_DEALLOC_TAIL;
+}
+
+static int SdBusMessageBuffer_getbuffer(SdBusMessageBufferObject* self, Py_buffer* view, int flags) {
+        if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+                PyErr_SetString(PyExc_BufferError, "Message buffer is read-only");
+                view->obj = NULL;
+                return -1;
+        }
+
+        view->buf = (void*)self->buffer_ptr;
+        view->len = self->buffer_size;
+        view->readonly = 1;
+        view->ndim = 1;
+        view->itemsize = self->item_size;
+        view->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) ? (char*)self->format : NULL;
+        view->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? &self->items_count : NULL;
+        view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? &self->item_size : NULL;
+        view->suboffsets = NULL;
+        view->internal = NULL;
+
+        Py_INCREF(self);
+        view->obj = (PyObject*)self;
+        return 0;
+}
+
+PyType_Spec SdBusMessageBufferType = {
+    .name = "sd_bus_internals.SdBusMessageBuffer",
+    .basicsize = sizeof(SdBusMessageBufferObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT,
+    .slots =
+        (PyType_Slot[]){
+            {Py_tp_new, PyType_GenericNew},
+            {Py_tp_dealloc, (destructor)SdBusMessageBuffer_dealloc},
+            {Py_bf_getbuffer, (getbufferproc)SdBusMessageBuffer_getbuffer},
+            {0, NULL},
+        },
+};
+#endif
+
+static PyObject* _message_buffer_view(_Iter_state* iter_state, const void* buffer_ptr, size_t buffer_size, const char* format, size_t item_size) {
+        // Read-only memoryview over message body. The exporter holds
+        // the reference to the message so the memory stays valid.
+        if (buffer_ptr == NULL) {
+                // Empty arrays have no data pointer
+                buffer_ptr = "";
+        }
+#ifdef SD_BUS_PY_BUFFER_EXPORT
+        PyObject* new_buffer_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessageBuffer_class));
+        SdBusMessageBufferObject* new_buffer = (SdBusMessageBufferObject*)new_buffer_object;
+        Py_INCREF(iter_state->message_object);
+        new_buffer->message_object = iter_state->message_object;
+        new_buffer->buffer_ptr = buffer_ptr;
+        new_buffer->buffer_size = (Py_ssize_t)buffer_size;
+        new_buffer->item_size = (Py_ssize_t)item_size;
+        new_buffer->items_count = (Py_ssize_t)(buffer_size / item_size);
+        new_buffer->format = format;
+        return PyMemoryView_FromObject(new_buffer_object);
+#else
+        // No buffer exporting support. Fallback to a copy.
+        PyObject* buffer_bytes CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyBytes_FromStringAndSize(buffer_ptr, (Py_ssize_t)buffer_size));
+        PyObject* bytes_view CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyMemoryView_FromObject(buffer_bytes));
+        (void)iter_state;
+        (void)item_size;
+        return PyObject_CallMethod(bytes_view, "cast", "s", format);
+#endif
+}
+
+static PyObject* _iter_bytes_array(_Iter_state* iter_state) {
         // Byte array
         const void* char_array = NULL;
         size_t array_size = 0;
-        CALL_SD_BUS_AND_CHECK(sd_bus_message_read_array(parser->message, 'y', &char_array, &array_size));
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_read_array(iter_state->message, 'y', &char_array, &array_size));
+        if (iter_state->bytes_as_memoryview) {
+                return _message_buffer_view(iter_state, char_array, array_size, "B", 1);
+        }
         return PyBytes_FromStringAndSize(char_array, (Py_ssize_t)array_size);
 }
 
-static PyObject* _iter_dict(_Parse_state* parser) {
-        PyObject* new_dict CLEANUP_PY_OBJECT = PyDict_New();
+#define _ITER_FIXED_ARRAY_FILL(c_type, py_converter)                                                    \
+        ({                                                                                              \
+                const c_type* typed_array = array_ptr;                                                  \
+                size_t elements_count = array_size / sizeof(c_type);                                    \
+                new_list = CALL_PYTHON_AND_CHECK(PyList_New((Py_ssize_t)elements_count));               \
+                for (size_t i = 0; i < elements_count; ++i) {                                           \
+                        SD_BUS_PY_LIST_SET_ITEM(new_list, i, CALL_PYTHON_AND_CHECK(py_converter(typed_array[i]))); \
+                }                                                                                       \
+        })
+
+static PyObject* _iter_fixed_array(_Iter_state* iter_state, char element_type) {
+        // Arrays of trivial types are stored continuously and
+        // can be read in one go.
+        const void* array_ptr = NULL;
+        size_t array_size = 0;
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_read_array(iter_state->message, element_type, &array_ptr, &array_size));
+
+        if (iter_state->arrays_as_buffer && element_type != 'b') {
+                const char* buffer_format = NULL;
+                switch (element_type) {
+                        case 'n':
+                                buffer_format = "h";
+                                break;
+                        case 'q':
+                                buffer_format = "H";
+                                break;
+                        case 'i':
+                                buffer_format = "i";
+                                break;
+                        case 'u':
+                                buffer_format = "I";
+                                break;
+                        case 'x':
+                                buffer_format = "q";
+                                break;
+                        case 't':
+                                buffer_format = "Q";
+                                break;
+                        case 'd':
+                                buffer_format = "d";
+                                break;
+                }
+                return _message_buffer_view(iter_state, array_ptr, array_size, buffer_format, _fixed_type_size(element_type));
+        }
 
-        char peek_type = '\0';
-        const char* container_type = NULL;
-        while (CALL_SD_BUS_AND_CHECK(sd_bus_message_peek_type(parser->message, &peek_type, &container_type)) > 0) {
-                if (peek_type != SD_BUS_TYPE_DICT_ENTRY) {
-                        PyErr_SetString(PyExc_TypeError, "Expected dict entry.");
-                        return NULL;
+        PyObject* new_list CLEANUP_PY_OBJECT = NULL;
+        switch (element_type) {
+                case 'b': {
+                        _ITER_FIXED_ARRAY_FILL(int32_t, PyBool_FromLong);
+                        break;
+                }
+                case 'n': {
+                        _ITER_FIXED_ARRAY_FILL(int16_t, PyLong_FromLong);
+                        break;
                 }
-                CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(parser->message, peek_type, container_type));
-                PyObject* key_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_basic(parser->message, container_type[0]));
-                PyObject* value_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_complete(parser));
-                CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(parser->message));
-                if (PyDict_SetItem(new_dict, key_object, value_object) < 0) {
+                case 'q': {
+                        _ITER_FIXED_ARRAY_FILL(uint16_t, PyLong_FromUnsignedLong);
+                        break;
+                }
+                case 'i': {
+                        _ITER_FIXED_ARRAY_FILL(int32_t, PyLong_FromLong);
+                        break;
+                }
+                case 'u': {
+                        _ITER_FIXED_ARRAY_FILL(uint32_t, PyLong_FromUnsignedLong);
+                        break;
+                }
+                case 'x': {
+                        _ITER_FIXED_ARRAY_FILL(int64_t, PyLong_FromLongLong);
+                        break;
+                }
+                case 't': {
+                        _ITER_FIXED_ARRAY_FILL(uint64_t, PyLong_FromUnsignedLongLong);
+                        break;
+                }
+                case 'd': {
+                        _ITER_FIXED_ARRAY_FILL(double, PyFloat_FromDouble);
+                        break;
+                }
+                default: {
+                        PyErr_Format(PyExc_TypeError, "Dbus type %c is not a fixed size type", (int)element_type);
                         return NULL;
                 }
         }
 
-        Py_INCREF(new_dict);
-        return new_dict;
+        Py_INCREF(new_list);
+        return new_list;
 }
 
-static PyObject* _iter_array(_Parse_state* parser) {
-        PyObject* new_list CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyList_New(0));
-        char peek_type = '\0';
-        const char* container_type = NULL;
+static PyObject* _iter_string_array(_Iter_state* iter_state, char string_type) {
+        // Strings are decoded straight from the message buffer.
+        // sd_bus_message_read_strv would copy every string first and
+        // older libsystemd only accepts "as" there.
+        const char container_signature[2] = {string_type, '\0'};
+
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(iter_state->message, SD_BUS_TYPE_ARRAY, container_signature));
+        // Counting pass so that the list is allocated once
+        Py_ssize_t elements_count = 0;
+        const char* new_string = NULL;
+        while (CALL_SD_BUS_AND_CHECK(sd_bus_message_read_basic(iter_state->message, string_type, &new_string)) > 0) {
+                ++elements_count;
+        }
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_rewind(iter_state->message, 0));
 
-        while (CALL_SD_BUS_AND_CHECK(sd_bus_message_peek_type(parser->message, &peek_type, &container_type)) > 0) {
-                PyObject* new_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_complete(parser));
-                if (PyList_Append(new_list, new_object) < 0) {
-                        return NULL;
-                }
+        PyObject* new_list CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyList_New(elements_count));
+        for (Py_ssize_t i = 0; i < elements_count; ++i) {
+                SD_BUS_PY_LIST_SET_ITEM(new_list, i, CALL_PYTHON_AND_CHECK(_iter_cached_string(iter_state, string_type)));
         }
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(iter_state->message));
+
         Py_INCREF(new_list);
         return new_list;
 }
 
-static PyObject* _iter_struct(_Parse_state* parser) {
-        const char* container_sig = sd_bus_message_get_signature(parser->message, 0);
-        if (container_sig == NULL) {
-                PyErr_SetString(PyExc_TypeError, "Failed to get container signature");
+static PyObject* _struct_constructor(const SdBusSignatureNode* struct_node) {
+        // New reference to the registered struct type or NULL
+        if (PyDict_Size(struct_types_dict) == 0) {
                 return NULL;
         }
-        size_t tuple_size = _container_size(container_sig);
+        PyObject* constructor = PyDict_GetItemString(struct_types_dict, struct_node->contents);
+        Py_XINCREF(constructor);
+        return constructor;
+}
 
-        if (tuple_size == 0) {
-                return NULL;
+static PyObject* _iter_dict(_Iter_state* iter_state, const SdBusSignatureNode* array_node) {
+        const SdBusSignatureNode* dict_entry_node = array_node + 1;
+        const SdBusSignatureNode* key_node = dict_entry_node + 1;
+        const SdBusSignatureNode* value_node = key_node + key_node->size;
+
+        PyObject* new_dict CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyDict_New());
+
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(iter_state->message, SD_BUS_TYPE_ARRAY, array_node->contents));
+        while (CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(iter_state->message, SD_BUS_TYPE_DICT_ENTRY, dict_entry_node->contents)) > 0) {
+                PyObject* key_object CLEANUP_PY_OBJECT = NULL;
+                if (key_node->type == 's' || key_node->type == 'o' || key_node->type == 'g') {
+                        // Names and paths used as keys repeat between messages
+                        key_object = CALL_PYTHON_AND_CHECK(_iter_cached_string(iter_state, key_node->type));
+                } else {
+                        key_object = CALL_PYTHON_AND_CHECK(_iter_basic(iter_state->message, key_node->type));
+                }
+                PyObject* value_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_complete(iter_state, value_node));
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(iter_state->message));
+                CALL_PYTHON_INT_CHECK(PyDict_SetItem(new_dict, key_object, value_object));
         }
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(iter_state->message));
+
+        Py_INCREF(new_dict);
+        return new_dict;
+}
 
-        PyObject* new_tuple CLEANUP_PY_OBJECT = PyTuple_New((Py_ssize_t)tuple_size);
-        for (size_t i = 0; i < tuple_size; ++i) {
-                PyObject* new_complete = CALL_PYTHON_AND_CHECK(_iter_complete(parser));
+static PyObject* _iter_array(_Iter_state* iter_state, const SdBusSignatureNode* array_node) {
+        const SdBusSignatureNode* element_node = array_node + 1;
+        switch (element_node->type) {
+                case 'y': {
+                        return _iter_bytes_array(iter_state);
+                }
+                case 'g':
+                case 'o':
+                case 's': {
+                        return _iter_string_array(iter_state, element_node->type);
+                }
+                case 'b':
+                case 'n':
+                case 'q':
+                case 'i':
+                case 'u':
+                case 'x':
+                case 't':
+                case 'd': {
+                        return _iter_fixed_array(iter_state, element_node->type);
+                }
+                case SD_BUS_TYPE_DICT_ENTRY: {
+                        return _iter_dict(iter_state, array_node);
+                }
+                default:
+                        break;
+        }
+
+        // Registered struct type is looked up once per array
+        PyObject* struct_constructor CLEANUP_PY_OBJECT = element_node->type == SD_BUS_TYPE_STRUCT ? _struct_constructor(element_node) : NULL;
+
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(iter_state->message, SD_BUS_TYPE_ARRAY, array_node->contents));
+        // Skipping elements does not create any Python objects
+        Py_ssize_t elements_count = 0;
+        while (CALL_SD_BUS_AND_CHECK(sd_bus_message_at_end(iter_state->message, 0)) == 0) {
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_skip(iter_state->message, NULL));
+                ++elements_count;
+        }
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_rewind(iter_state->message, 0));
+
+        PyObject* new_list CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyList_New(elements_count));
+        for (Py_ssize_t i = 0; i < elements_count; ++i) {
+                PyObject* new_object = CALL_PYTHON_AND_CHECK(struct_constructor != NULL ? _iter_struct(iter_state, element_node, struct_constructor)
+                                                                                        : _iter_complete(iter_state, element_node));
+                SD_BUS_PY_LIST_SET_ITEM(new_list, i, new_object);
+        }
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(iter_state->message));
+
+        Py_INCREF(new_list);
+        return new_list;
+}
+
+static PyObject* _iter_complete_types(_Iter_state* iter_state, const SdBusSignatureNode* first_node, size_t complete_types_count) {
+        PyObject* new_tuple CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyTuple_New((Py_ssize_t)complete_types_count));
+        const SdBusSignatureNode* node = first_node;
+        for (size_t i = 0; i < complete_types_count; ++i) {
+                PyObject* new_complete = CALL_PYTHON_AND_CHECK(_iter_complete(iter_state, node));
                 SD_BUS_PY_TUPLE_SET_ITEM(new_tuple, i, new_complete);
+                node += node->size;
         }
         Py_INCREF(new_tuple);
         return new_tuple;
 }
 
-static PyObject* _iter_variant(_Parse_state* parser) {
-        const char* container_sig = sd_bus_message_get_signature(parser->message, 0);
-        PyObject* value_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_complete(parser));
-        PyObject* variant_sig_str CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyUnicode_FromString(container_sig));
-        return PyTuple_Pack(2, variant_sig_str, value_object);
-}
+#if !defined(Py_LIMITED_API) && PY_VERSION_HEX >= 0x03090000
+#define STRUCT_VECTORCALL_MAX_MEMBERS 16
+#endif
 
-static PyObject* _iter_complete(_Parse_state* parser) {
-        const char* container_signature = NULL;
-        char complete_type = '\0';
-        // TODO: can be optimized with custom parser instead of constantly
-        // peeking
-        CALL_SD_BUS_AND_CHECK(sd_bus_message_peek_type(parser->message, &complete_type, &container_signature));
-        switch (complete_type) {
-                case 'a': {
-                        if (strcmp(container_signature, "y") == 0) {
-                                return _iter_bytes_array(parser);
+static PyObject* _iter_struct(_Iter_state* iter_state, const SdBusSignatureNode* struct_node, PyObject* constructor) {
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(iter_state->message, SD_BUS_TYPE_STRUCT, struct_node->contents));
+#ifdef STRUCT_VECTORCALL_MAX_MEMBERS
+        if (constructor != NULL && struct_node->members_count <= STRUCT_VECTORCALL_MAX_MEMBERS) {
+                // Members are passed to the registered type without
+                // building an intermediate tuple.
+                PyObject* members[STRUCT_VECTORCALL_MAX_MEMBERS];
+                size_t members_read = 0;
+                const SdBusSignatureNode* node = struct_node + 1;
+                for (; members_read < struct_node->members_count; ++members_read) {
+                        members[members_read] = _iter_complete(iter_state, node);
+                        if (members[members_read] == NULL) {
+                                break;
                         }
+                        node += node->size;
+                }
+                PyObject* new_object = NULL;
+                if (members_read == struct_node->members_count) {
+                        new_object = PyObject_Vectorcall(constructor, members, members_read, NULL);
+                }
+                for (size_t i = 0; i < members_read; ++i) {
+                        Py_DECREF(members[i]);
+                }
+                if (new_object == NULL) {
+                        return NULL;
+                }
+                int exit_return = sd_bus_message_exit_container(iter_state->message);
+                if (exit_return < 0) {
+                        Py_DECREF(new_object);
+                        CALL_SD_BUS_AND_CHECK(exit_return);
+                }
+                return new_object;
+        }
+#endif
+        PyObject* new_tuple CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_complete_types(iter_state, struct_node + 1, struct_node->members_count));
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(iter_state->message));
 
-                        if (container_signature[0] == '{') {
-                                CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(parser->message, complete_type, container_signature));
-                                PyObject* new_dict = CALL_PYTHON_AND_CHECK(_iter_dict(parser));
-                                CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(parser->message));
-                                return new_dict;
-                        }
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(parser->message, complete_type, container_signature));
-                        PyObject* new_array = CALL_PYTHON_AND_CHECK(_iter_array(parser));
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(parser->message));
-                        return new_array;
-                        break;
+        if (constructor != NULL) {
+                return PyObject_CallObject(constructor, new_tuple);
+        }
+        Py_INCREF(new_tuple);
+        return new_tuple;
+}
+
+static PyObject* _iter_variant_value(_Iter_state* iter_state, PyObject** variant_sig_str_out) {
+        char variant_type = '\0';
+        const char* variant_signature = NULL;
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_peek_type(iter_state->message, &variant_type, &variant_signature));
+        PyObject* variant_sig_str CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusStringCache_get_string(iter_state->string_cache, variant_signature));
+        PyObject* variant_plan_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusSignature_get_plan(variant_sig_str));
+        const SdBusSignaturePlan* variant_plan = _SdBusSignature_plan_from_capsule(variant_plan_capsule);
+
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(iter_state->message, SD_BUS_TYPE_VARIANT, variant_plan->signature));
+        PyObject* value_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_complete(iter_state, variant_plan->nodes));
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(iter_state->message));
+
+        if (variant_sig_str_out != NULL) {
+                Py_INCREF(variant_sig_str);
+                *variant_sig_str_out = variant_sig_str;
+        }
+        Py_INCREF(value_object);
+        return value_object;
+}
+
+static PyObject* _iter_variant(_Iter_state* iter_state) {
+        PyObject* variant_sig_str CLEANUP_PY_OBJECT = NULL;
+        PyObject* value_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_variant_value(iter_state, &variant_sig_str));
+
+        return PyTuple_Pack(2, variant_sig_str, value_object);
+}
+
+static PyObject* _iter_complete(_Iter_state* iter_state, const SdBusSignatureNode* node) {
+        switch (node->type) {
+                case SD_BUS_TYPE_ARRAY: {
+                        return _iter_array(iter_state, node);
                 }
-                case 'v': {
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(parser->message, complete_type, container_signature));
-                        PyObject* new_variant = CALL_PYTHON_AND_CHECK(_iter_variant(parser));
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(parser->message));
-                        return new_variant;
-                        break;
+                case SD_BUS_TYPE_VARIANT: {
+                        return _iter_variant(iter_state);
                 }
-                case 'r': {
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(parser->message, complete_type, container_signature));
-                        PyObject* new_tuple = CALL_PYTHON_AND_CHECK(_iter_struct(parser));
-                        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(parser->message));
-                        return new_tuple;
-                        break;
+                case SD_BUS_TYPE_STRUCT: {
+                        PyObject* constructor CLEANUP_PY_OBJECT = _struct_constructor(node);
+                        return _iter_struct(iter_state, node, constructor);
+                }
+                case 'o':
+                case 'g': {
+                        return _iter_cached_string(iter_state, node->type);
                 }
                 default: {
-                        return _iter_basic(parser->message, complete_type);
-                        break;
+                        return _iter_basic(iter_state->message, node->type);
                 }
         }
 }
 
-static PyObject* iter_tuple_or_single(_Parse_state* parser) {
-        // Calculate the length of message data
-        size_t container_size = _container_size(parser->container_char_ptr);
-        if (container_size == 0) {
-                return NULL;
+static int _iter_state_init(_Iter_state* iter_state, SdBusMessageObject* message_object, const char* arrays_mode, const char* byte_arrays_mode) {
+        iter_state->message = message_object->message_ref;
+        iter_state->message_object = message_object;
+        iter_state->arrays_as_buffer = 0;
+        iter_state->bytes_as_memoryview = 0;
+        iter_state->string_cache_capsule = NULL;
+        iter_state->string_cache = NULL;
+
+        if (strcmp(arrays_mode, "buffer") == 0) {
+                iter_state->arrays_as_buffer = 1;
+        } else if (strcmp(arrays_mode, "list") != 0) {
+                PyErr_Format(PyExc_ValueError, "Expected 'list' or 'buffer' arrays mode, got '%s'", arrays_mode);
+                return -1;
+        }
+        if (strcmp(byte_arrays_mode, "memoryview") == 0) {
+                iter_state->bytes_as_memoryview = 1;
+        } else if (strcmp(byte_arrays_mode, "bytes") != 0) {
+                PyErr_Format(PyExc_ValueError, "Expected 'bytes' or 'memoryview' byte arrays mode, got '%s'", byte_arrays_mode);
+                return -1;
         }
 
-        if (container_size == 1) {
-                return _iter_complete(parser);
+        sd_bus* message_bus = sd_bus_message_get_bus(iter_state->message);
+        // Closed bus might be already released by its SdBus object
+        int create_cache = message_bus != NULL && sd_bus_is_open(message_bus) > 0;
+        iter_state->string_cache_capsule = CALL_PYTHON_CHECK_RETURN_NEG1(_SdBusStringCache_capsule_for_bus(message_bus, create_cache));
+        iter_state->string_cache = _SdBusStringCache_from_capsule(iter_state->string_cache_capsule);
+        return 0;
+}
+
+static PyObject* _iter_plan(_Iter_state* iter_state, const SdBusSignaturePlan* plan) {
+        /* Parsing strategy
+       Either return a single object (single string, single int, single array)
+       or a tuple of single objects. This mirrors the python function returns.
+      */
+        if (plan->complete_types_count == 1) {
+                return _iter_complete(iter_state, plan->nodes);
         } else {
-                return _iter_struct(parser);
+                return _iter_complete_types(iter_state, plan->nodes, plan->complete_types_count);
         }
 }
 
-static PyObject* SdBusMessage_get_contents2(SdBusMessageObject* self, PyObject* Py_UNUSED(args)) {
+static PyObject* SdBusMessage_get_contents2(SdBusMessageObject* self, PyObject* args, PyObject* kwargs) {
+        static char* kwlist[] = {"arrays", "byte_arrays", NULL};
+        const char* arrays_char_ptr = "list";
+        const char* byte_arrays_char_ptr = "bytes";
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTupleAndKeywords(args, kwargs, "|$ss", kwlist, &arrays_char_ptr, &byte_arrays_char_ptr));
+
+        _Iter_state iter_state CLEANUP_ITER_STATE = {.string_cache_capsule = NULL};
+        CALL_PYTHON_INT_CHECK(_iter_state_init(&iter_state, self, arrays_char_ptr, byte_arrays_char_ptr));
+
         const char* message_signature = sd_bus_message_get_signature(self->message_ref, 0);
 
         if (message_signature == NULL) {
@@ -966,18 +1196,136 @@ static PyObject* SdBusMessage_get_contents2(SdBusMessageObject* self, PyObject*
                 Py_RETURN_NONE;
         }
 
+        PyObject* message_signature_str CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyUnicode_FromString(message_signature));
+        PyObject* plan_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusSignature_get_plan(message_signature_str));
+        const SdBusSignaturePlan* plan = _SdBusSignature_plan_from_capsule(plan_capsule);
+
         CALL_SD_BUS_AND_CHECK(sd_bus_message_rewind(self->message_ref, 0));
-        _Parse_state read_parser = {
-            .message = self->message_ref,
-            .container_char_ptr = message_signature,
-            .index = 0,
-            .max_index = strlen(message_signature),
-        };
-        /* Parsing strategy
-       Either return a single object (single string, single int, single array)
-       or a tuple of single objects. This mirrors the python function returns.
-      */
-        return iter_tuple_or_single(&read_parser);
+        return _iter_plan(&iter_state, plan);
+}
+
+// Cursor methods
+//
+// Message keeps the read position between calls so the contents
+// can be read piece by piece. read_data and skip move the position
+// over the complete types in the given signature. Containers can be
+// entered with enter_container and left with exit_container.
+
+static PyObject* SdBusMessage_read_data(SdBusMessageObject* self, PyObject* args, PyObject* kwargs) {
+        static char* kwlist[] = {"", "arrays", "byte_arrays", NULL};
+        PyObject* signature_str = NULL;
+        const char* arrays_char_ptr = "list";
+        const char* byte_arrays_char_ptr = "bytes";
+        CALL_PYTHON_BOOL_CHECK(
+            PyArg_ParseTupleAndKeywords(args, kwargs, "U|$ss", kwlist, &signature_str, &arrays_char_ptr, &byte_arrays_char_ptr));
+
+        _Iter_state iter_state CLEANUP_ITER_STATE = {.string_cache_capsule = NULL};
+        CALL_PYTHON_INT_CHECK(_iter_state_init(&iter_state, self, arrays_char_ptr, byte_arrays_char_ptr));
+
+        PyObject* plan_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_SdBusSignature_get_plan(signature_str));
+        const SdBusSignaturePlan* plan = _SdBusSignature_plan_from_capsule(plan_capsule);
+        if (plan->complete_types_count == 0) {
+                PyErr_SetString(PyExc_TypeError, "Data signature too short");
+                return NULL;
+        }
+
+        return _iter_plan(&iter_state, plan);
+}
+
+static PyObject* SdBusMessage_read_properties_dict(SdBusMessageObject* self, PyObject* args, PyObject* kwargs) {
+        // Reads a{sv} properties dict without variant signatures.
+        // Optionally property names are translated with name map.
+        static char* kwlist[] = {"name_map", "on_unknown_member", NULL};
+        PyObject* name_map = Py_None;
+        const char* on_unknown_member_char_ptr = "error";
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTupleAndKeywords(args, kwargs, "|$Os", kwlist, &name_map, &on_unknown_member_char_ptr));
+
+        if (name_map != Py_None && !PyDict_Check(name_map)) {
+                PyErr_Format(PyExc_TypeError, "Expected dict or None name map, got %R", name_map);
+                return NULL;
+        }
+        int ignore_unknown = 0;
+        int reuse_unknown = 0;
+        if (strcmp(on_unknown_member_char_ptr, "ignore") == 0) {
+                ignore_unknown = 1;
+        } else if (strcmp(on_unknown_member_char_ptr, "reuse") == 0) {
+                reuse_unknown = 1;
+        } else if (strcmp(on_unknown_member_char_ptr, "error") != 0) {
+                PyErr_Format(PyExc_ValueError, "Expected 'error', 'ignore' or 'reuse' unknown member mode, got '%s'", on_unknown_member_char_ptr);
+                return NULL;
+        }
+
+        _Iter_state iter_state CLEANUP_ITER_STATE = {.string_cache_capsule = NULL};
+        CALL_PYTHON_INT_CHECK(_iter_state_init(&iter_state, self, "list", "bytes"));
+
+        PyObject* new_dict CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyDict_New());
+
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(self->message_ref, SD_BUS_TYPE_ARRAY, "{sv}"));
+        while (CALL_SD_BUS_AND_CHECK(sd_bus_message_enter_container(self->message_ref, SD_BUS_TYPE_DICT_ENTRY, "sv")) > 0) {
+                PyObject* member_name CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_cached_string(&iter_state, 's'));
+                PyObject* python_name = member_name;
+                if (name_map != Py_None) {
+                        python_name = PyDict_GetItemWithError(name_map, member_name);
+                        if (python_name == NULL) {
+                                PYTHON_ERR_OCCURED;
+                                if (ignore_unknown) {
+                                        CALL_SD_BUS_AND_CHECK(sd_bus_message_skip(self->message_ref, "v"));
+                                        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(self->message_ref));
+                                        continue;
+                                } else if (reuse_unknown) {
+                                        python_name = member_name;
+                                } else {
+                                        PyErr_SetObject(PyExc_KeyError, member_name);
+                                        return NULL;
+                                }
+                        }
+                }
+
+                PyObject* value_object CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_iter_variant_value(&iter_state, NULL));
+                CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(self->message_ref));
+                CALL_PYTHON_INT_CHECK(PyDict_SetItem(new_dict, python_name, value_object));
+        }
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_exit_container(self->message_ref));
+
+        Py_INCREF(new_dict);
+        return new_dict;
+}
+
+#ifndef Py_LIMITED_API
+static PyObject* SdBusMessage_skip(SdBusMessageObject* self, PyObject* const* args, Py_ssize_t nargs) {
+        SD_BUS_PY_CHECK_ARGS_NUMBER(1);
+        SD_BUS_PY_CHECK_ARG_CHECK_FUNC(0, PyUnicode_Check);
+
+        const char* signature_char_ptr = SD_BUS_PY_UNICODE_AS_CHAR_PTR(args[0]);
+#else
+static PyObject* SdBusMessage_skip(SdBusMessageObject* self, PyObject* args) {
+        const char* signature_char_ptr = NULL;
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "s", &signature_char_ptr, NULL));
+#endif
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_skip(self->message_ref, signature_char_ptr));
+
+        Py_RETURN_NONE;
+}
+
+static PyObject* SdBusMessage_peek_type(SdBusMessageObject* self, PyObject* Py_UNUSED(args)) {
+        char next_type = '\0';
+        const char* next_contents = NULL;
+        if (CALL_SD_BUS_AND_CHECK(sd_bus_message_peek_type(self->message_ref, &next_type, &next_contents)) == 0) {
+                // End of message or current container
+                Py_RETURN_NONE;
+        }
+
+        return Py_BuildValue("(C,s)", (int)next_type, next_contents != NULL ? next_contents : "");
+}
+
+static PyObject* SdBusMessage_at_end(SdBusMessageObject* self, PyObject* Py_UNUSED(args)) {
+        return PyBool_FromLong(CALL_SD_BUS_AND_CHECK(sd_bus_message_at_end(self->message_ref, 0)));
+}
+
+static PyObject* SdBusMessage_rewind(SdBusMessageObject* self, PyObject* Py_UNUSED(args)) {
+        CALL_SD_BUS_AND_CHECK(sd_bus_message_rewind(self->message_ref, 1));
+
+        Py_RETURN_NONE;
 }
 
 #ifndef Py_LIMITED_API
@@ -994,6 +1342,7 @@ static SdBusMessageObject* SdBusMessage_create_error_reply(SdBusMessageObject* s
         const char* error_message = NULL;
         CALL_PYTHON_BOOL_CHECK(PyArg_ParseTuple(args, "ss", &name, &error_message, NULL));
 #endif
+        _wait_message_bus(self->message_ref);
         SdBusMessageObject* new_reply_message CLEANUP_SD_BUS_MESSAGE =
             (SdBusMessageObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
 
@@ -1011,7 +1360,15 @@ static PyMethodDef SdBusMessage_methods[] = {
     {"exit_container", (PyCFunction)SdBusMessage_exit_container, METH_NOARGS, PyDoc_STR("Exit container.")},
     {"dump", (PyCFunction)SdBusMessage_dump, METH_NOARGS, PyDoc_STR("Dump message to stdout.")},
     {"seal", (PyCFunction)SdBusMessage_seal, METH_NOARGS, PyDoc_STR("Seal message contents.")},
-    {"get_contents", (PyCFunction)SdBusMessage_get_contents2, METH_NOARGS, PyDoc_STR("Iterate over message contents.")},
+    {"get_contents", (PyCFunction)(void (*)(void))SdBusMessage_get_contents2, METH_VARARGS | METH_KEYWORDS, PyDoc_STR("Iterate over message contents.")},
+    {"read_data", (PyCFunction)(void (*)(void))SdBusMessage_read_data, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR("Read data based on signature from the current position.")},
+    {"read_properties_dict", (PyCFunction)(void (*)(void))SdBusMessage_read_properties_dict, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR("Read a{sv} properties dict with variants unwrapped and optionally names translated.")},
+    {"skip", (SD_BUS_PY_FUNC_TYPE)SdBusMessage_skip, SD_BUS_PY_METH, PyDoc_STR("Skip data based on signature from the current position.")},
+    {"peek_type", (PyCFunction)SdBusMessage_peek_type, METH_NOARGS, PyDoc_STR("Get type and contents signature of the next data or None at the end.")},
+    {"at_end", (PyCFunction)SdBusMessage_at_end, METH_NOARGS, PyDoc_STR("Is current container read to the end?")},
+    {"rewind", (PyCFunction)SdBusMessage_rewind, METH_NOARGS, PyDoc_STR("Move read position back to the start of message.")},
     {"create_reply", (PyCFunction)SdBusMessage_create_reply, METH_NOARGS, PyDoc_STR("Create reply message.")},
     {"create_error_reply", (SD_BUS_PY_FUNC_TYPE)SdBusMessage_create_error_reply, SD_BUS_PY_METH,
      PyDoc_STR("Create error reply with error name and error message.")},
@@ -0,0 +1,394 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/*
+    Copyright (C) 2020, 2021 igo95862
+
+    This file is part of python-sdbus
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+#include "sd_bus_internals.h"
+
+// SdBusPendingCall
+//
+// Awaitable returned by SdBus.call_async. Holds the sd-bus slot and
+// the reply directly instead of going through asyncio.Future methods.
+//
+// Implements the same protocol as asyncio.Future: asyncio tasks
+// recognize it by _asyncio_future_blocking attribute and use
+// add_done_callback, result and cancel to wait on it.
+//
+// Slot is released as soon as the call is finished, cancelled or
+// garbage collected so sd-bus drops the reply tracking right away
+// instead of keeping it until the reply or the timeout.
+//
+// Same as asyncio.Future an error that was never retrieved with
+// result or exception is reported to the loop exception handler
+// when the call is finalized.
+
+enum {
+        PENDING_CALL_PENDING,
+        PENDING_CALL_FINISHED,
+        PENDING_CALL_CANCELLED,
+};
+
+static void _release_slot(SdBusPendingCallObject* self) {
+        if (self->slot_ref == NULL) {
+                return;
+        }
+        _SdBus_wait_blocking_call(sd_bus_slot_get_bus(self->slot_ref));
+        self->slot_ref = sd_bus_slot_unref(self->slot_ref);
+        if (self->bus != NULL) {
+                ((SdBusObject*)self->bus)->pending_calls_count--;
+        }
+}
+
+static int SdBusPendingCall_traverse(SdBusPendingCallObject* self, visitproc visit, void* arg) {
+        Py_VISIT(Py_TYPE(self));
+        Py_VISIT(self->bus);
+        Py_VISIT(self->loop);
+        Py_VISIT(self->result);
+        Py_VISIT(self->exception);
+        Py_VISIT(self->callbacks);
+        Py_VISIT(self->cancel_message);
+        return 0;
+}
+
+static int SdBusPendingCall_clear(SdBusPendingCallObject* self) {
+        // Unreachable call can never be awaited
+        _release_slot(self);
+        Py_CLEAR(self->bus);
+        Py_CLEAR(self->loop);
+        Py_CLEAR(self->result);
+        Py_CLEAR(self->exception);
+        Py_CLEAR(self->callbacks);
+        Py_CLEAR(self->cancel_message);
+        return 0;
+}
+
+static void SdBusPendingCall_finalize(SdBusPendingCallObject* self) {
+        if (!self->log_exception || self->exception == NULL || self->loop == NULL) {
+                return;
+        }
+        self->log_exception = 0;
+
+        // Finalizer must not change the current exception
+        PyObject *error_type, *error_value, *error_traceback;
+        PyErr_Fetch(&error_type, &error_value, &error_traceback);
+
+        // Call itself is not passed as it might be already deallocating
+        PyObject* context CLEANUP_PY_OBJECT =
+            Py_BuildValue("{sssO}", "message", "SdBusPendingCall exception was never retrieved", "exception", self->exception);
+        PyObject* handler_result CLEANUP_PY_OBJECT = NULL;
+        if (context != NULL) {
+                handler_result = PyObject_CallMethod(self->loop, "call_exception_handler", "O", context);
+        }
+        if (handler_result == NULL) {
+                PyErr_WriteUnraisable(self->loop);
+        }
+
+        PyErr_Restore(error_type, error_value, error_traceback);
+}
+
+static void SdBusPendingCall_dealloc(SdBusPendingCallObject* self) {
+        PyObject_GC_UnTrack(self);
+        SdBusPendingCall_finalize(self);
+        SdBusPendingCall_clear(self);
+
+        SD_BUS_DEALLOC_TAIL;
+}
+
+static int _schedule_callbacks(SdBusPendingCallObject* self) {
+        if (self->callbacks == NULL) {
+                return 0;
+        }
+        PyObject* callbacks CLEANUP_PY_OBJECT = self->callbacks;
+        self->callbacks = NULL;
+
+        PyObject* call_soon CLEANUP_PY_OBJECT = CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_GetAttr(self->loop, call_soon_str));
+        Py_ssize_t callbacks_count = SD_BUS_PY_LIST_GET_SIZE(callbacks);
+        for (Py_ssize_t i = 0; i < callbacks_count; ++i) {
+                PyObject* callback_tuple = PyList_GetItem(callbacks, i);
+                PyObject* callback = PyTuple_GetItem(callback_tuple, 0);
+                PyObject* context = PyTuple_GetItem(callback_tuple, 1);
+                PyObject* call_args CLEANUP_PY_OBJECT = CALL_PYTHON_CHECK_RETURN_NEG1(PyTuple_Pack(2, callback, self));
+                PyObject* call_kwargs CLEANUP_PY_OBJECT = NULL;
+                if (context != Py_None) {
+                        call_kwargs = CALL_PYTHON_CHECK_RETURN_NEG1(Py_BuildValue("{sO}", "context", context));
+                }
+                Py_XDECREF(CALL_PYTHON_CHECK_RETURN_NEG1(PyObject_Call(call_soon, call_args, call_kwargs)));
+        }
+        return 0;
+}
+
+static int _finish_pending_call(SdBusPendingCallObject* self, PyObject* result, PyObject* exception) {
+        self->state = PENDING_CALL_FINISHED;
+        Py_XINCREF(result);
+        self->result = result;
+        Py_XINCREF(exception);
+        self->exception = exception;
+        self->log_exception = exception != NULL;
+        return _schedule_callbacks(self);
+}
+
+int _SdBusPendingCall_callback(sd_bus_message* m, void* userdata, sd_bus_error* Py_UNUSED(ret_error)) {
+        SdBusPendingCallObject* self = userdata;
+        // Reply slot is no longer needed once the reply arrived
+        Py_INCREF(self);
+        PyObject* self_ref CLEANUP_PY_OBJECT = (PyObject*)self;
+        _release_slot(self);
+
+        if (self->state != PENDING_CALL_PENDING) {
+                return 0;
+        }
+
+        if (sd_bus_message_is_method_error(m, NULL)) {
+                PyObject* new_exception CLEANUP_PY_OBJECT = CALL_PYTHON_CHECK_RETURN_NEG1(_SdBus_exception_from_message(m));
+                return _finish_pending_call(self, NULL, new_exception);
+        }
+
+        SdBusMessageObject* reply_message_object CLEANUP_SD_BUS_MESSAGE =
+            (SdBusMessageObject*)CALL_PYTHON_CHECK_RETURN_NEG1(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusMessage_class));
+        _SdBusMessage_set_messsage(reply_message_object, m);
+        return _finish_pending_call(self, (PyObject*)reply_message_object, NULL);
+}
+
+PyObject* _SdBusPendingCall_new(PyObject* bus, PyObject* loop) {
+        SdBusPendingCallObject* new_pending_call = (SdBusPendingCallObject*)CALL_PYTHON_AND_CHECK(SD_BUS_PY_CLASS_DUNDER_NEW(SdBusPendingCall_class));
+        Py_INCREF(bus);
+        new_pending_call->bus = bus;
+        Py_INCREF(loop);
+        new_pending_call->loop = loop;
+        return (PyObject*)new_pending_call;
+}
+
+static PyObject* _new_cancelled_error(SdBusPendingCallObject* self) {
+        if (self->cancel_message != NULL && self->cancel_message != Py_None) {
+                return PyObject_CallFunctionObjArgs(asyncio_cancelled_error, self->cancel_message, NULL);
+        }
+        return PyObject_CallFunctionObjArgs(asyncio_cancelled_error, NULL);
+}
+
+static PyObject* _raise_if_not_finished(SdBusPendingCallObject* self) {
+        if (self->state == PENDING_CALL_CANCELLED) {
+                PyObject* cancelled_error CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_new_cancelled_error(self));
+                PyErr_SetObject(asyncio_cancelled_error, cancelled_error);
+                return NULL;
+        }
+        if (self->state == PENDING_CALL_PENDING) {
+                PyErr_SetString(asyncio_invalid_state_error, "Result is not ready.");
+                return NULL;
+        }
+        Py_RETURN_NONE;
+}
+
+static PyObject* SdBusPendingCall_result(SdBusPendingCallObject* self, PyObject* Py_UNUSED(args)) {
+        Py_XDECREF(CALL_PYTHON_AND_CHECK(_raise_if_not_finished(self)));
+        self->log_exception = 0;
+        if (self->exception != NULL) {
+                PyErr_SetObject((PyObject*)Py_TYPE(self->exception), self->exception);
+                return NULL;
+        }
+        Py_INCREF(self->result);
+        return self->result;
+}
+
+static PyObject* SdBusPendingCall_exception(SdBusPendingCallObject* self, PyObject* Py_UNUSED(args)) {
+        Py_XDECREF(CALL_PYTHON_AND_CHECK(_raise_if_not_finished(self)));
+        self->log_exception = 0;
+        if (self->exception != NULL) {
+                Py_INCREF(self->exception);
+                return self->exception;
+        }
+        Py_RETURN_NONE;
+}
+
+static PyObject* SdBusPendingCall_done(SdBusPendingCallObject* self, PyObject* Py_UNUSED(args)) {
+        return PyBool_FromLong(self->state != PENDING_CALL_PENDING);
+}
+
+static PyObject* SdBusPendingCall_cancelled(SdBusPendingCallObject* self, PyObject* Py_UNUSED(args)) {
+        return PyBool_FromLong(self->state == PENDING_CALL_CANCELLED);
+}
+
+static PyObject* SdBusPendingCall_get_loop(SdBusPendingCallObject* self, PyObject* Py_UNUSED(args)) {
+        Py_INCREF(self->loop);
+        return self->loop;
+}
+
+static PyObject* SdBusPendingCall_cancel(SdBusPendingCallObject* self, PyObject* args, PyObject* kwargs) {
+        PyObject* cancel_message = Py_None;
+        static char* kwlist[] = {"msg", NULL};
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTupleAndKeywords(args, kwargs, "|O", kwlist, &cancel_message));
+
+        if (self->state != PENDING_CALL_PENDING) {
+                Py_RETURN_FALSE;
+        }
+        if (self->slot_ref != NULL) {
+                // Stops the reply callback, reply will be ignored by sd-bus
+                _release_slot(self);
+                ((SdBusObject*)self->bus)->cancelled_calls_count++;
+        }
+        self->state = PENDING_CALL_CANCELLED;
+        Py_INCREF(cancel_message);
+        self->cancel_message = cancel_message;
+        CALL_PYTHON_INT_CHECK(_schedule_callbacks(self));
+        Py_RETURN_TRUE;
+}
+
+static PyObject* SdBusPendingCall_make_cancelled_error(SdBusPendingCallObject* self, PyObject* Py_UNUSED(args)) {
+        return _new_cancelled_error(self);
+}
+
+static PyObject* SdBusPendingCall_add_done_callback(SdBusPendingCallObject* self, PyObject* args, PyObject* kwargs) {
+        PyObject* callback = NULL;
+        PyObject* context = Py_None;
+        static char* kwlist[] = {"", "context", NULL};
+        CALL_PYTHON_BOOL_CHECK(PyArg_ParseTupleAndKeywords(args, kwargs, "O|$O", kwlist, &callback, &context));
+
+        PyObject* callback_tuple CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyTuple_Pack(2, callback, context));
+        if (self->callbacks == NULL) {
+                self->callbacks = CALL_PYTHON_AND_CHECK(PyList_New(0));
+        }
+        CALL_PYTHON_INT_CHECK(PyList_Append(self->callbacks, callback_tuple));
+
+        if (self->state != PENDING_CALL_PENDING) {
+                CALL_PYTHON_INT_CHECK(_schedule_callbacks(self));
+        }
+        Py_RETURN_NONE;
+}
+
+static PyObject* SdBusPendingCall_remove_done_callback(SdBusPendingCallObject* self, PyObject* callback) {
+        if (self->callbacks == NULL) {
+                return PyLong_FromLong(0);
+        }
+
+        PyObject* kept_callbacks CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyList_New(0));
+        Py_ssize_t callbacks_count = SD_BUS_PY_LIST_GET_SIZE(self->callbacks);
+        for (Py_ssize_t i = 0; i < callbacks_count; ++i) {
+                PyObject* callback_tuple = PyList_GetItem(self->callbacks, i);
+                int is_equal = CALL_PYTHON_INT_CHECK(PyObject_RichCompareBool(PyTuple_GetItem(callback_tuple, 0), callback, Py_EQ));
+                if (!is_equal) {
+                        CALL_PYTHON_INT_CHECK(PyList_Append(kept_callbacks, callback_tuple));
+                }
+        }
+
+        Py_ssize_t removed_count = callbacks_count - SD_BUS_PY_LIST_GET_SIZE(kept_callbacks);
+        PyObject* old_callbacks CLEANUP_PY_OBJECT = self->callbacks;
+        self->callbacks = kept_callbacks;
+        kept_callbacks = NULL;
+        return PyLong_FromSsize_t(removed_count);
+}
+
+static PyObject* SdBusPendingCall_await(SdBusPendingCallObject* self) {
+        Py_INCREF(self);
+        return (PyObject*)self;
+}
+
+static PyObject* SdBusPendingCall_iternext(SdBusPendingCallObject* self) {
+        if (self->state == PENDING_CALL_PENDING) {
+                // Yield self to the task which will wait on done callback
+                self->blocking = 1;
+                Py_INCREF(self);
+                return (PyObject*)self;
+        }
+
+        PyObject* result CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(SdBusPendingCall_result(self, NULL));
+        PyErr_SetObject(PyExc_StopIteration, result);
+        return NULL;
+}
+
+static PyObject* SdBusPendingCall_blocking_getter(SdBusPendingCallObject* self, void* Py_UNUSED(closure)) {
+        return PyBool_FromLong(self->blocking);
+}
+
+static int SdBusPendingCall_blocking_setter(SdBusPendingCallObject* self, PyObject* new_value, void* Py_UNUSED(closure)) {
+        if (NULL == new_value) {
+                PyErr_SetString(PyExc_AttributeError, "Can't delete _asyncio_future_blocking");
+                return -1;
+        }
+
+        int new_bool = PyObject_IsTrue(new_value);
+        if (new_bool < 0) {
+                return -1;
+        }
+        self->blocking = new_bool;
+        return 0;
+}
+
+static PyObject* SdBusPendingCall_log_traceback_getter(SdBusPendingCallObject* self, void* Py_UNUSED(closure)) {
+        return PyBool_FromLong(self->log_exception);
+}
+
+static int SdBusPendingCall_log_traceback_setter(SdBusPendingCallObject* self, PyObject* new_value, void* Py_UNUSED(closure)) {
+        if (NULL == new_value) {
+                PyErr_SetString(PyExc_AttributeError, "Can't delete _log_traceback");
+                return -1;
+        }
+
+        int new_bool = PyObject_IsTrue(new_value);
+        if (new_bool < 0) {
+                return -1;
+        }
+        if (new_bool) {
+                PyErr_SetString(PyExc_ValueError, "_log_traceback can only be set to False");
+                return -1;
+        }
+        self->log_exception = 0;
+        return 0;
+}
+
+static PyMethodDef SdBusPendingCall_methods[] = {
+    {"result", (PyCFunction)SdBusPendingCall_result, METH_NOARGS, PyDoc_STR("Return reply message or raise the error.")},
+    {"exception", (PyCFunction)SdBusPendingCall_exception, METH_NOARGS, PyDoc_STR("Return the error or None.")},
+    {"done", (PyCFunction)SdBusPendingCall_done, METH_NOARGS, PyDoc_STR("Return True if reply arrived or call was cancelled.")},
+    {"cancelled", (PyCFunction)SdBusPendingCall_cancelled, METH_NOARGS, PyDoc_STR("Return True if call was cancelled.")},
+    {"get_loop", (PyCFunction)SdBusPendingCall_get_loop, METH_NOARGS, PyDoc_STR("Return event loop the call belongs to.")},
+    {"cancel", (PyCFunction)(void (*)(void))SdBusPendingCall_cancel, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR("Cancel the call. Reply will be ignored.")},
+    {"_make_cancelled_error", (PyCFunction)SdBusPendingCall_make_cancelled_error, METH_NOARGS, PyDoc_STR("Create CancelledError.")},
+    {"add_done_callback", (PyCFunction)(void (*)(void))SdBusPendingCall_add_done_callback, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR("Add callback called with the call when done.")},
+    {"remove_done_callback", (PyCFunction)SdBusPendingCall_remove_done_callback, METH_O, PyDoc_STR("Remove done callback.")},
+    {NULL, NULL, 0, NULL},
+};
+
+static PyGetSetDef SdBusPendingCall_properies[] = {
+    {"_asyncio_future_blocking", (getter)SdBusPendingCall_blocking_getter, (setter)SdBusPendingCall_blocking_setter,
+     PyDoc_STR("Used by asyncio tasks to wait on the call."), NULL},
+    {"_log_traceback", (getter)SdBusPendingCall_log_traceback_getter, (setter)SdBusPendingCall_log_traceback_setter,
+     PyDoc_STR("True if the error was not retrieved yet."), NULL},
+    {0},
+};
+
+PyType_Spec SdBusPendingCallType = {
+    .name = "sd_bus_internals.SdBusPendingCall",
+    .basicsize = sizeof(SdBusPendingCallObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .slots =
+        (PyType_Slot[]){
+            {Py_tp_new, PyType_GenericNew},
+            {Py_tp_dealloc, (destructor)SdBusPendingCall_dealloc},
+            {Py_tp_traverse, (traverseproc)SdBusPendingCall_traverse},
+            {Py_tp_clear, (inquiry)SdBusPendingCall_clear},
+            {Py_tp_finalize, (destructor)SdBusPendingCall_finalize},
+            {Py_tp_methods, SdBusPendingCall_methods},
+            {Py_tp_getset, SdBusPendingCall_properies},
+            {Py_tp_iter, SdBusPendingCall_await},
+            {Py_tp_iternext, SdBusPendingCall_iternext},
+            {Py_am_await, SdBusPendingCall_await},
+            {0, NULL},
+        },
+};
@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/*
+    Copyright (C) 2020, 2021 igo95862
+
+    This file is part of python-sdbus
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+#include "sd_bus_internals.h"
+
+// Signature plans
+//
+// Signature string is compiled once in to a flat array of nodes in
+// the signature order. Every container node is followed by its
+// members so the next complete type is always at node + node->size.
+// Container contents signatures are copied once so they can be
+// passed to sd-bus directly.
+//
+// "a{sv}i"
+//  0: 'a' size 4 contents "{sv}"
+//  1: 'e' size 3 contents "sv" members 2
+//  2: 's' size 1
+//  3: 'v' size 1
+//  4: 'i' size 1
+
+#define SIGNATURE_MAX_LENGTH 255
+#define SIGNATURE_PLANS_CACHE_MAX 1024
+
+static const char signature_plan_capsule_name[] = "sd_bus_internals.SignaturePlan";
+
+static int _is_basic_type(char type) {
+        return type != '\0' && strchr("ybnqiuxtdhsog", type) != NULL;
+}
+
+static int _compile_complete(const char* signature, size_t* index, SdBusSignatureNode* nodes, size_t* nodes_used);
+
+static int _compile_dict_entry(const char* signature, size_t* index, SdBusSignatureNode* nodes, size_t* nodes_used) {
+        // Initial state
+        // "...{sv}..."
+        //     ^
+        SdBusSignatureNode* dict_entry_node = &nodes[*nodes_used];
+        size_t node_index = (*nodes_used)++;
+        (*index)++;
+
+        size_t contents_start = *index;
+        if (!_is_basic_type(signature[*index])) {
+                PyErr_SetString(PyExc_TypeError, "D-Bus dict key must be a basic type");
+                return -1;
+        }
+        if (_compile_complete(signature, index, nodes, nodes_used) < 0) {
+                return -1;
+        }
+        if (signature[*index] == '}') {
+                PyErr_SetString(PyExc_TypeError, "End of dict reached instead of complete type");
+                return -1;
+        }
+        if (signature[*index] == '\0') {
+                PyErr_SetString(PyExc_TypeError, "Reached the end of signature before the dict end");
+                return -1;
+        }
+        if (_compile_complete(signature, index, nodes, nodes_used) < 0) {
+                return -1;
+        }
+        if (signature[*index] != '}') {
+                PyErr_SetString(PyExc_TypeError, "D-Bus dict entry must have exactly one key and one value");
+                return -1;
+        }
+        // "...{sv}..."
+        //         ^
+        dict_entry_node->type = SD_BUS_TYPE_DICT_ENTRY;
+        dict_entry_node->members_count = 2;
+        dict_entry_node->contents = signature + contents_start;
+        dict_entry_node->contents_length = *index - contents_start;
+        dict_entry_node->size = *nodes_used - node_index;
+        (*index)++;
+        return 0;
+}
+
+static int _compile_complete(const char* signature, size_t* index, SdBusSignatureNode* nodes, size_t* nodes_used) {
+        char type = signature[*index];
+        switch (type) {
+                case '\0': {
+                        PyErr_SetString(PyExc_TypeError, "Data signature too short");
+                        return -1;
+                }
+                case '}': {
+                        PyErr_SetString(PyExc_TypeError,
+                                        "End of dict reached instead "
+                                        "of complete type");
+                        return -1;
+                }
+                case ')': {
+                        PyErr_SetString(PyExc_TypeError,
+                                        "End of struct reached "
+                                        "instead of complete type");
+                        return -1;
+                }
+                case '{': {
+                        PyErr_SetString(PyExc_TypeError, "D-Bus dict can't be outside of array");
+                        return -1;
+                }
+                default:
+                        break;
+        }
+
+        SdBusSignatureNode* node = &nodes[*nodes_used];
+        size_t node_index = (*nodes_used)++;
+        node->type = type;
+        node->members_count = 0;
+        node->contents = NULL;
+        node->contents_length = 0;
+
+        switch (type) {
+                case 'a': {
+                        // "...a{sx}..."
+                        //     ^
+                        (*index)++;
+                        size_t contents_start = *index;
+                        if (signature[*index] == '\0') {
+                                PyErr_SetString(PyExc_TypeError,
+                                                "Reached the end of signature before "
+                                                "the array end");
+                                return -1;
+                        }
+                        if (signature[*index] == '{') {
+                                if (_compile_dict_entry(signature, index, nodes, nodes_used) < 0) {
+                                        return -1;
+                                }
+                        } else {
+                                if (_compile_complete(signature, index, nodes, nodes_used) < 0) {
+                                        return -1;
+                                }
+                        }
+                        node->contents = signature + contents_start;
+                        node->contents_length = *index - contents_start;
+                        break;
+                }
+                case '(': {
+                        // "...(...)..."
+                        //     ^
+                        (*index)++;
+                        size_t contents_start = *index;
+                        while (signature[*index] != ')') {
+                                if (signature[*index] == '\0') {
+                                        PyErr_SetString(PyExc_TypeError, "Reached the end of signature before the struct end");
+                                        return -1;
+                                }
+                                if (_compile_complete(signature, index, nodes, nodes_used) < 0) {
+                                        return -1;
+                                }
+                                node->members_count++;
+                        }
+                        if (node->members_count == 0) {
+                                PyErr_SetString(PyExc_TypeError, "D-Bus struct can't be empty");
+                                return -1;
+                        }
+                        node->type = SD_BUS_TYPE_STRUCT;
+                        node->contents = signature + contents_start;
+                        node->contents_length = *index - contents_start;
+                        (*index)++;
+                        break;
+                }
+                case 'v': {
+                        (*index)++;
+                        break;
+                }
+                default: {
+                        if (!_is_basic_type(type)) {
+                                PyErr_Format(PyExc_ValueError, "Unknown message append type: %c", (int)type);
+                                return -1;
+                        }
+                        (*index)++;
+                        break;
+                }
+        }
+
+        node->size = *nodes_used - node_index;
+        return 0;
+}
+
+static void _signature_plan_capsule_destructor(PyObject* capsule) {
+        free(PyCapsule_GetPointer(capsule, signature_plan_capsule_name));
+}
+
+static PyObject* _compile_signature_plan(PyObject* signature_str) {
+#ifndef Py_LIMITED_API
+        const char* signature_char_ptr = SD_BUS_PY_UNICODE_AS_CHAR_PTR(signature_str);
+#else
+        PyObject* signature_bytes CLEANUP_PY_OBJECT = SD_BUS_PY_UNICODE_AS_BYTES(signature_str);
+        const char* signature_char_ptr = SD_BUS_PY_BYTES_AS_CHAR_PTR(signature_bytes);
+#endif
+        size_t signature_length = strlen(signature_char_ptr);
+        if (signature_length > SIGNATURE_MAX_LENGTH) {
+                PyErr_Format(PyExc_TypeError, "Signature is longer than %i characters", SIGNATURE_MAX_LENGTH);
+                return NULL;
+        }
+
+        // Every node consumes at least one signature character
+        SdBusSignatureNode compiled_nodes[SIGNATURE_MAX_LENGTH];
+        size_t nodes_used = 0;
+        size_t complete_types_count = 0;
+        size_t index = 0;
+        while (signature_char_ptr[index] != '\0') {
+                if (_compile_complete(signature_char_ptr, &index, compiled_nodes, &nodes_used) < 0) {
+                        return NULL;
+                }
+                complete_types_count++;
+        }
+
+        size_t strings_size = signature_length + 1;
+        for (size_t i = 0; i < nodes_used; ++i) {
+                if (compiled_nodes[i].contents != NULL) {
+                        strings_size += compiled_nodes[i].contents_length + 1;
+                }
+        }
+
+        SdBusSignaturePlan* new_plan = malloc(sizeof(SdBusSignaturePlan) + nodes_used * sizeof(SdBusSignatureNode) + strings_size);
+        if (new_plan == NULL) {
+                return PyErr_NoMemory();
+        }
+        new_plan->complete_types_count = complete_types_count;
+        new_plan->nodes_count = nodes_used;
+
+        char* strings_ptr = (char*)(new_plan->nodes + nodes_used);
+        memcpy(strings_ptr, signature_char_ptr, signature_length + 1);
+        new_plan->signature = strings_ptr;
+        strings_ptr += signature_length + 1;
+
+        for (size_t i = 0; i < nodes_used; ++i) {
+                new_plan->nodes[i] = compiled_nodes[i];
+                if (compiled_nodes[i].contents != NULL) {
+                        memcpy(strings_ptr, compiled_nodes[i].contents, compiled_nodes[i].contents_length);
+                        strings_ptr[compiled_nodes[i].contents_length] = '\0';
+                        new_plan->nodes[i].contents = strings_ptr;
+                        strings_ptr += compiled_nodes[i].contents_length + 1;
+                }
+        }
+
+        PyObject* new_capsule = PyCapsule_New(new_plan, signature_plan_capsule_name, _signature_plan_capsule_destructor);
+        if (new_capsule == NULL) {
+                free(new_plan);
+                return NULL;
+        }
+        return new_capsule;
+}
+
+PyObject* _SdBusSignature_get_plan(PyObject* signature_str) {
+        if (!PyUnicode_Check(signature_str)) {
+                PyErr_Format(PyExc_TypeError, "Expected signature str, got %R", signature_str);
+                return NULL;
+        }
+
+        PyObject* cached_plan = PyDict_GetItemWithError(signature_plans_dict, signature_str);
+        if (cached_plan != NULL) {
+                Py_INCREF(cached_plan);
+                return cached_plan;
+        }
+        PYTHON_ERR_OCCURED;
+
+        PyObject* new_plan CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_compile_signature_plan(signature_str));
+
+        if (PyDict_Size(signature_plans_dict) >= SIGNATURE_PLANS_CACHE_MAX) {
+                // Plans in use are kept alive by their callers
+                PyDict_Clear(signature_plans_dict);
+        }
+        CALL_PYTHON_INT_CHECK(PyDict_SetItem(signature_plans_dict, signature_str, new_plan));
+
+        Py_INCREF(new_plan);
+        return new_plan;
+}
+
+const SdBusSignaturePlan* _SdBusSignature_plan_from_capsule(PyObject* plan_capsule) {
+        return PyCapsule_GetPointer(plan_capsule, signature_plan_capsule_name);
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/*
+    Copyright (C) 2020, 2021 igo95862
+
+    This file is part of python-sdbus
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+#include "sd_bus_internals.h"
+
+// String cache
+//
+// Every bus has a fixed size direct mapped table of recently decoded
+// short strings. Names, object paths and dict keys repeat in almost
+// every message so the same str objects can be returned instead of
+// allocating new ones. Entry is replaced on hash collision.
+//
+// Caches are stored in string_caches_dict keyed by sd_bus pointer
+// because messages only know the sd_bus they belong to.
+
+static const char string_cache_capsule_name[] = "sd_bus_internals.StringCache";
+
+static void _string_cache_capsule_destructor(PyObject* capsule) {
+        SdBusStringCache* cache = PyCapsule_GetPointer(capsule, string_cache_capsule_name);
+        for (size_t i = 0; i < cache->entries_count; ++i) {
+                Py_XDECREF(cache->entries[i].string);
+        }
+        free(cache);
+}
+
+static PyObject* _new_string_cache_capsule(size_t entries_count) {
+        SdBusStringCache* new_cache = calloc(1, sizeof(SdBusStringCache) + entries_count * sizeof(SdBusStringCacheEntry));
+        if (new_cache == NULL) {
+                return PyErr_NoMemory();
+        }
+        new_cache->entries_count = entries_count;
+
+        PyObject* new_capsule = PyCapsule_New(new_cache, string_cache_capsule_name, _string_cache_capsule_destructor);
+        if (new_capsule == NULL) {
+                free(new_cache);
+                return NULL;
+        }
+        return new_capsule;
+}
+
+PyObject* _SdBusStringCache_capsule_for_bus(sd_bus* bus, int create) {
+        if (bus == NULL) {
+                Py_RETURN_NONE;
+        }
+
+        PyObject* bus_key CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(PyLong_FromVoidPtr(bus));
+        PyObject* cache_capsule = PyDict_GetItemWithError(string_caches_dict, bus_key);
+        if (cache_capsule != NULL) {
+                Py_INCREF(cache_capsule);
+                return cache_capsule;
+        }
+        PYTHON_ERR_OCCURED;
+        if (!create) {
+                Py_RETURN_NONE;
+        }
+
+        PyObject* new_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_AND_CHECK(_new_string_cache_capsule(SD_BUS_STRING_CACHE_DEFAULT_SIZE));
+        CALL_PYTHON_INT_CHECK(PyDict_SetItem(string_caches_dict, bus_key, new_capsule));
+        Py_INCREF(new_capsule);
+        return new_capsule;
+}
+
+SdBusStringCache* _SdBusStringCache_from_capsule(PyObject* cache_capsule) {
+        if (cache_capsule == NULL || cache_capsule == Py_None) {
+                return NULL;
+        }
+        return PyCapsule_GetPointer(cache_capsule, string_cache_capsule_name);
+}
+
+int _SdBusStringCache_resize(sd_bus* bus, size_t new_size) {
+        PyObject* bus_key CLEANUP_PY_OBJECT = CALL_PYTHON_CHECK_RETURN_NEG1(PyLong_FromVoidPtr(bus));
+        PyObject* new_capsule CLEANUP_PY_OBJECT = CALL_PYTHON_CHECK_RETURN_NEG1(_new_string_cache_capsule(new_size));
+        return PyDict_SetItem(string_caches_dict, bus_key, new_capsule);
+}
+
+void _SdBusStringCache_remove(sd_bus* bus) {
+        // Called from dealloc which must not change the current exception
+        PyObject *error_type, *error_value, *error_traceback;
+        PyErr_Fetch(&error_type, &error_value, &error_traceback);
+
+        PyObject* bus_key CLEANUP_PY_OBJECT = PyLong_FromVoidPtr(bus);
+        if (bus_key == NULL || PyDict_DelItem(string_caches_dict, bus_key) < 0) {
+                // Bus never decoded any messages
+                PyErr_Clear();
+        }
+
+        PyErr_Restore(error_type, error_value, error_traceback);
+}
+
+PyObject* _SdBusStringCache_get_string(SdBusStringCache* cache, const char* string) {
+        if (cache == NULL || cache->entries_count == 0) {
+                return PyUnicode_FromString(string);
+        }
+
+        // FNV-1a hash
+        uint64_t string_hash = 14695981039346656037ULL;
+        size_t length = 0;
+        for (; string[length] != '\0'; ++length) {
+                if (length == SD_BUS_STRING_CACHE_MAX_LENGTH) {
+                        // Long strings are unlikely to repeat
+                        return PyUnicode_FromString(string);
+                }
+                string_hash ^= (uint8_t)string[length];
+                string_hash *= 1099511628211ULL;
+        }
+
+        SdBusStringCacheEntry* entry = &cache->entries[string_hash % cache->entries_count];
+        if (entry->string != NULL && entry->length == length && memcmp(entry->key, string, length) == 0) {
+                cache->hits++;
+                Py_INCREF(entry->string);
+                return entry->string;
+        }
+
+        cache->misses++;
+        PyObject* new_string = CALL_PYTHON_AND_CHECK(PyUnicode_FromStringAndSize(string, (Py_ssize_t)length));
+        Py_XDECREF(entry->string);
+        Py_INCREF(new_string);
+        entry->string = new_string;
+        entry->length = length;
+        memcpy(entry->key, string, length);
+        return new_string;
+}
@@ -236,6 +236,7 @@ class IsolatedDbusTestCase(IsolatedAsyncioTestCase):
         if isinstance(signal, DbusSignalAsyncLocalBind):
             return DbusSignalRecorderLocal(self, timeout, signal)
         elif isinstance(signal, DbusSignalAsyncProxyBind):
-            return DbusSignalRecorderRemote(self, timeout, self.bus, signal)
+            return DbusSignalRecorderRemote(
+                self, timeout, signal.proxy_meta.attached_bus, signal)
         else:
             raise TypeError("Unknown or unsupported signal class.")
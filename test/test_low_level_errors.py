@@ -22,8 +22,8 @@ from __future__ import annotations
 from asyncio import get_running_loop, wait_for
 from typing import Any
 
-from sdbus.dbus_common_elements import DbusLocalObjectMeta
 from sdbus.exceptions import DbusFailedError
+from sdbus.sd_bus_internals import SdBusInterface
 from sdbus.unittest import IsolatedDbusTestCase
 
 from sdbus import (
@@ -164,47 +164,50 @@ class TestLowLevelErrors(IsolatedDbusTestCase):
 
         await self.test_object_connection.hello_world()
 
+    def _export_broken_interface(
+        self,
+        interface: SdBusInterface,
+    ) -> InterfaceWithErrors:
+        # Callbacks are resolved when the interface is added to the bus
+        self.bus.add_interface(interface, '/broken', 'org.example.test')
+        return InterfaceWithErrors.new_proxy('org.test', '/broken')
+
     async def test_property_callback_error(self) -> None:
-        dbus_local_meta = self.test_object._dbus
-        if not isinstance(dbus_local_meta, DbusLocalObjectMeta):
-            raise TypeError
-        interface = dbus_local_meta.activated_interfaces[0]
-        interface.property_get_dict.pop(b'DerriveErrSettable')
+        def test_raise(*args: Any, **kwargs: Any) -> None:
+            raise IndependentError
+
+        interface = SdBusInterface()
+        interface.add_property('DerriveErrSettable', 's', test_raise, None, 0)
+        broken_connection = self._export_broken_interface(interface)
 
         with self.assertRaises(DbusFailedError):
             await wait_for(
-                self.test_object_connection.derrive_err_settable,
+                broken_connection.derrive_err_settable,
                 timeout=1,
             )
 
     async def test_method_callback_error(self) -> None:
-        TEST_KEY = b'HelloWorld'
-        dbus_local_meta = self.test_object._dbus
-        if not isinstance(dbus_local_meta, DbusLocalObjectMeta):
-            raise TypeError
-        interface = dbus_local_meta.activated_interfaces[0]
-        interface.method_dict.pop(TEST_KEY)
+        def test_independent_raise(*args: Any, **kwargs: Any) -> None:
+            raise IndependentError
 
-        with self.assertRaises(DbusFailedError):
-            await wait_for(
-                self.test_object_connection.hello_world(),
-                timeout=1,
-            )
+        def test_raise(*args: Any, **kwargs: Any) -> None:
+            raise DbusDerivePropertydError
 
-        interface.method_dict[TEST_KEY] = None
+        interface = SdBusInterface()
+        interface.add_method(
+            'HelloWorld', '', (), 's', (), 0, test_independent_raise)
+        interface.add_method('HelloError', '', (), 's', (), 0, test_raise)
+        broken_connection = self._export_broken_interface(interface)
 
-        with self.assertRaises(TypeError):
+        with self.assertRaises(DbusFailedError) as cm:
             await wait_for(
-                self.test_object_connection.hello_world(),
+                broken_connection.hello_world(),
                 timeout=1,
             )
+        self.assertIs(cm.exception.__class__, DbusFailedError)
 
-        def test_raise(*args: Any, **kwargs: Any) -> None:
-            raise DbusDerivePropertydError
-
-        interface.method_dict[TEST_KEY] = test_raise
         with self.assertRaises(DbusDerivePropertydError):
             await wait_for(
-                self.test_object_connection.hello_world(),
+                broken_connection.hello_error(),
                 timeout=1,
             )
@@ -19,10 +19,15 @@
 # Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
 from __future__ import annotations
 
-from typing import Dict, List
+from typing import Any, Dict, List, Tuple, cast
 from unittest import main
 
-from sdbus.sd_bus_internals import SdBus, SdBusMessage
+from sdbus.sd_bus_internals import (
+    SdBus,
+    SdBusMessage,
+    register_struct_type,
+    unregister_struct_type,
+)
 from sdbus.unittest import IsolatedDbusTestCase
 
 from sdbus import SdBusLibraryError
@@ -440,6 +445,341 @@ class TestDbusTypes(IsolatedDbusTestCase):
                 "test",
             )
 
+    def test_signature_reuse(self) -> None:
+        test_data = (
+            [('x', 1), ('(sas)', ('test', ['a', 'b']))],
+            {'test': ('a{sv}', {'nested': ('x', 2)})},
+        )
+
+        for _ in range(5):
+            message = create_message(self.bus)
+            message.append_data('ava{sv}', *test_data)
+            message.seal()
+
+            self.assertEqual(message.get_contents(), test_data)
+
+    def test_typed_arrays(self) -> None:
+        message = create_message(self.bus)
+
+        test_data: Tuple[List[Any], ...] = (
+            [True, False, True],
+            [-(2**15), 0, 2**15-1],
+            [0, 2**16-1],
+            [-(2**31), 0, 2**31-1],
+            [0, 2**32-1],
+            [-(2**63), 0, 2**63-1],
+            [0, 2**64-1],
+            [-1.5, 0.0, 1e300],
+            ['test', ''],
+            ['/', '/test/object'],
+            ['s', 'a{sv}'],
+            [],
+            [[1, 2], [], [3]],
+        )
+        message.append_data('abanaqaiauaxatadasaoagasaai', *test_data)
+        message.seal()
+
+        self.assertEqual(message.get_contents(), test_data)
+
+    def test_buffer_arrays(self) -> None:
+        from array import array
+
+        message = create_message(self.bus)
+
+        test_doubles = array('d', (x / 3 for x in range(1000)))
+        test_ints = array('i', range(-500, 500))
+        test_uint64 = array('Q', (0, 2**64-1))
+        test_shorts = memoryview(array('h', (-1, 0, 1)))
+        test_bytes = memoryview(b'test_bytes')
+        test_bools = memoryview(b'\x00\x01\x05').cast('?')
+
+        message.append_data(
+            'adaiatanayab',
+            test_doubles, test_ints, test_uint64,
+            test_shorts, test_bytes, test_bools,
+        )
+
+        self.assertRaises(
+            TypeError, message.append_data, 'ai', array('d', (1.0, )))
+        self.assertRaises(
+            TypeError, message.append_data, 'ax', array('i', (1, )))
+        self.assertRaises(
+            TypeError, message.append_data, 'au', array('i', (1, )))
+        self.assertRaises(
+            TypeError, message.append_data, 'ai', (1, 2))
+
+        message.seal()
+
+        self.assertEqual(
+            message.get_contents(),
+            (
+                test_doubles.tolist(), test_ints.tolist(),
+                test_uint64.tolist(), test_shorts.tolist(),
+                b'test_bytes', [False, True, True],
+            ),
+        )
+
+    def test_buffer_array_results(self) -> None:
+        from array import array
+
+        message = create_message(self.bus)
+
+        test_doubles = array('d', (x / 3 for x in range(1000)))
+        test_uint32 = array('I', (0, 2**32-1))
+        test_int64 = [-(2**63), 2**63-1]
+        test_strings = ['test', 'buffer']
+        message.append_data(
+            'adaua{sax}as',
+            test_doubles, test_uint32,
+            {'test': test_int64}, test_strings,
+        )
+        message.seal()
+
+        doubles_view, uint32_view, int64_dict, strings = cast(
+            Tuple[memoryview, memoryview, Dict[str, memoryview], List[str]],
+            message.get_contents(arrays='buffer'),
+        )
+
+        self.assertIsInstance(doubles_view, memoryview)
+        self.assertTrue(doubles_view.readonly)
+        self.assertEqual(doubles_view.format, 'd')
+        self.assertEqual(doubles_view.tolist(), test_doubles.tolist())
+        self.assertEqual(array('d', doubles_view), test_doubles)
+        self.assertEqual(uint32_view.tolist(), test_uint32.tolist())
+        self.assertEqual(int64_dict['test'].tolist(), test_int64)
+        self.assertEqual(strings, test_strings)
+
+        del message
+        self.assertEqual(doubles_view.tolist(), test_doubles.tolist())
+
+    def test_byte_array_views(self) -> None:
+        message = create_message(self.bus)
+
+        test_bytes = bytes(range(256)) * 16
+        message.append_data('ayaya{say}', test_bytes, b'', {'a': b'test'})
+        message.seal()
+
+        bytes_view, empty_view, bytes_dict = cast(
+            Tuple[memoryview, memoryview, Dict[str, memoryview]],
+            message.get_contents(byte_arrays='memoryview'),
+        )
+
+        self.assertIsInstance(bytes_view, memoryview)
+        self.assertTrue(bytes_view.readonly)
+        self.assertEqual(bytes_view.format, 'B')
+        self.assertEqual(bytes_view, test_bytes)
+        self.assertEqual(len(empty_view), 0)
+        self.assertEqual(bytes(bytes_dict['a']), b'test')
+
+        self.assertIsInstance(message.get_contents()[0], bytes)
+
+        del message
+        self.assertEqual(bytes(bytes_view), test_bytes)
+
+        self.assertRaises(
+            ValueError,
+            create_message(self.bus).get_contents,
+            byte_arrays='bytearray',
+        )
+
+    def test_message_cursor(self) -> None:
+        message = create_message(self.bus)
+
+        test_properties = {
+            'Foo': ('s', 'test'),
+            'Bar': ('ax', [1, 2, 3]),
+        }
+        message.append_data(
+            'sa{sv}as',
+            'org.example.test', test_properties, ['Baz'])
+        message.seal()
+
+        self.assertEqual(message.peek_type(), ('s', ''))
+        self.assertEqual(message.read_data('s'), 'org.example.test')
+        self.assertEqual(message.peek_type(), ('a', '{sv}'))
+        message.skip('a{sv}')
+        self.assertEqual(message.read_data('as'), ['Baz'])
+        self.assertTrue(message.at_end())
+        self.assertIsNone(message.peek_type())
+
+        message.rewind()
+        self.assertEqual(
+            message.read_data('sa{sv}'),
+            ('org.example.test', test_properties),
+        )
+
+        message.rewind()
+        message.skip('s')
+        message.enter_container('a', '{sv}')
+        self.assertEqual(message.peek_type(), ('e', 'sv'))
+        message.enter_container('e', 'sv')
+        self.assertEqual(message.read_data('s'), 'Foo')
+        self.assertEqual(message.peek_type(), ('v', 's'))
+        self.assertEqual(message.read_data('v'), ('s', 'test'))
+        self.assertTrue(message.at_end())
+        message.exit_container()
+        self.assertFalse(message.at_end())
+        message.exit_container()
+        self.assertEqual(message.read_data('as'), ['Baz'])
+
+        message.rewind()
+        self.assertEqual(message.get_contents()[0], 'org.example.test')
+
+        self.assertRaises(TypeError, message.read_data, '')
+        self.assertRaises(SdBusLibraryError, message.read_data, 'x')
+
+    def test_string_cache(self) -> None:
+        self.assertEqual(self.bus.string_cache_size, 256)
+
+        def decode_properties() -> Dict[str, Tuple[str, Any]]:
+            message = create_message(self.bus)
+            message.append_data(
+                'a{sv}o',
+                {'Foo': ('s', 'test'), 'Bar': ('o', '/test')}, '/')
+            message.seal()
+            properties, _ = cast(
+                Tuple[Dict[str, Tuple[str, Any]], str],
+                message.get_contents(),
+            )
+            return properties
+
+        hits_before = self.bus.string_cache_hits
+        misses_before = self.bus.string_cache_misses
+
+        first_properties = decode_properties()
+        second_properties = decode_properties()
+        self.assertEqual(first_properties, second_properties)
+        self.assertGreater(self.bus.string_cache_misses, misses_before)
+        self.assertGreater(self.bus.string_cache_hits, hits_before)
+
+        for first_key, second_key in zip(
+                first_properties, second_properties):
+            self.assertIs(first_key, second_key)
+
+        self.bus.string_cache_size = 0
+        self.assertEqual(self.bus.string_cache_size, 0)
+        decode_properties()
+        self.assertEqual(self.bus.string_cache_hits, 0)
+        self.assertEqual(self.bus.string_cache_misses, 0)
+
+        self.assertRaises(
+            ValueError, setattr, self.bus, 'string_cache_size', -1)
+
+    def test_read_properties_dict(self) -> None:
+        test_properties = {
+            'Foo': ('s', 'test'),
+            'Bar': ('v', ('x', 1)),
+            'Unknown': ('ai', [1, 2]),
+        }
+        name_map = {'Foo': 'foo', 'Bar': 'bar'}
+
+        def properties_message() -> SdBusMessage:
+            message = create_message(self.bus)
+            message.append_data('sa{sv}', 'org.example.test', test_properties)
+            message.seal()
+            message.skip('s')
+            return message
+
+        self.assertEqual(
+            properties_message().read_properties_dict(),
+            {'Foo': 'test', 'Bar': ('x', 1), 'Unknown': [1, 2]},
+        )
+        self.assertEqual(
+            properties_message().read_properties_dict(
+                name_map=name_map, on_unknown_member='ignore'),
+            {'foo': 'test', 'bar': ('x', 1)},
+        )
+        self.assertEqual(
+            properties_message().read_properties_dict(
+                name_map=name_map, on_unknown_member='reuse'),
+            {'foo': 'test', 'bar': ('x', 1), 'Unknown': [1, 2]},
+        )
+        with self.assertRaises(KeyError):
+            properties_message().read_properties_dict(name_map=name_map)
+        with self.assertRaises(ValueError):
+            properties_message().read_properties_dict(
+                name_map=name_map,
+                on_unknown_member='bad_mode',  # type: ignore[arg-type]
+            )
+        with self.assertRaises(TypeError):
+            properties_message().read_properties_dict(
+                name_map)  # type: ignore[call-arg]
+
+    def test_struct_types(self) -> None:
+        from typing import NamedTuple
+
+        class UnitInfo(NamedTuple):
+            name: str
+            state: str
+            path: str
+
+        register_struct_type('(sso)', UnitInfo)
+        self.addCleanup(unregister_struct_type, '(sso)')
+
+        test_units = [
+            ('foo.service', 'active', '/foo'),
+            ('bar.service', 'failed', '/bar'),
+        ]
+
+        message = create_message(self.bus)
+        message.append_data(
+            'a(sso)(sso)a{s(sso)}(ss)',
+            test_units, test_units[0],
+            {'bar': test_units[1]}, ('not', 'registered'),
+        )
+        message.seal()
+
+        units, single_unit, units_dict, other_struct = cast(
+            Tuple[List[UnitInfo], UnitInfo, Dict[str, UnitInfo], Any],
+            message.get_contents(),
+        )
+
+        self.assertEqual(units, [UnitInfo(*x) for x in test_units])
+        self.assertIsInstance(units[0], UnitInfo)
+        self.assertEqual(units[1].state, 'failed')
+        self.assertIsInstance(single_unit, UnitInfo)
+        self.assertIsInstance(units_dict['bar'], UnitInfo)
+        self.assertIs(type(other_struct), tuple)
+
+        unregister_struct_type('(sso)')
+        register_struct_type('(sso)', lambda *args: list(args))
+        self.assertEqual(
+            message.get_contents()[1],
+            list(test_units[0]),
+        )
+
+        self.assertRaises(ValueError, register_struct_type, 's', tuple)
+        self.assertRaises(TypeError, register_struct_type, '(s)', None)
+        self.assertRaises(KeyError, unregister_struct_type, '(s)')
+
+    def test_bad_signatures(self) -> None:
+        message = create_message(self.bus)
+
+        for bad_signature in ('(', '()', 'a', 'a{vs}', 'a{sss}', ')', 'a{s}'):
+            with self.subTest(bad_signature=bad_signature):
+                self.assertRaises(
+                    TypeError, message.append_data, bad_signature, 1)
+
+        self.assertRaises(
+            ValueError, message.append_data, 'z', 1)
+
+        self.assertRaises(
+            TypeError, message.append_data, '(xs)', (1, 'a', 'b'))
+
+        self.assertRaises(
+            TypeError, message.append_data, '(xs)', (1, ))
+
+        self.assertRaises(
+            TypeError, message.append_data, 'v', ('ss', 'a'))
+
+        self.assertRaises(
+            TypeError, message.append_data, 's', 'a', 'b')
+
+        message.append_data('s', 'test')
+        message.seal()
+
+        self.assertEqual(message.get_contents(), 'test')
+
 
 if __name__ == "__main__":
     main()
@@ -19,15 +19,37 @@
 # Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
 from __future__ import annotations
 
-from asyncio import Event, get_running_loop, sleep, wait_for
+from asyncio import (
+    AbstractEventLoop,
+    CancelledError,
+    Event,
+    Task,
+    current_task,
+    gather,
+    get_running_loop,
+    isfuture,
+    new_event_loop,
+    sleep,
+    wait_for,
+)
+from asyncio import TimeoutError as AsyncioTimeoutError
 from asyncio.subprocess import create_subprocess_exec
+from logging import getLogger
+from socket import AF_UNIX, SOCK_STREAM, socket, socketpair
+from sys import getrefcount, version_info
+from tempfile import TemporaryDirectory
+from time import monotonic
 from typing import TYPE_CHECKING, cast
 from unittest import SkipTest
+from unittest.mock import patch
 
+from sdbus.dbus_common_elements import DbusLocalObjectMeta
 from sdbus.exceptions import (
     DbusFailedError,
     DbusFileExistsError,
+    DbusNoReplyError,
     DbusPropertyReadOnlyError,
+    DbusUnknownMethodError,
     DbusUnknownObjectError,
     SdBusLibraryError,
     SdBusUnmappedMessageError,
@@ -35,6 +57,14 @@ from sdbus.exceptions import (
 from sdbus.sd_bus_internals import (
     DBUS_ERROR_TO_EXCEPTION,
     DbusPropertyEmitsChangeFlag,
+    DbusPropertyEmitsInvalidationFlag,
+    DbusPropertyExplicitFlag,
+    SdBusInterface,
+    SdBusMessage,
+    SdBusPendingCall,
+    sd_bus_open_peer_address,
+    sd_bus_open_peer_fd,
+    sd_bus_open_user,
 )
 from sdbus.unittest import IsolatedDbusTestCase
 from sdbus.utils import parse_properties_changed
@@ -42,6 +72,7 @@ from sdbus.utils import parse_properties_changed
 from sdbus import (
     DbusInterfaceCommonAsync,
     DbusNoReplyFlag,
+    DbusPeerServer,
     dbus_method_async,
     dbus_method_async_override,
     dbus_property_async,
@@ -51,11 +82,12 @@ from sdbus import (
 )
 
 if TYPE_CHECKING:
-    from typing import Tuple
+    from typing import Any, Dict, List, Tuple
 
     from sdbus.dbus_proxy_async_interfaces import (
         DBUS_PROPERTIES_CHANGED_TYPING,
     )
+    from sdbus.sd_bus_internals import SdBus
 else:
     DBUS_PROPERTIES_CHANGED_TYPING = None
 
@@ -245,6 +277,13 @@ def initialize_object() -> Tuple[TestInterface, TestInterface]:
     return test_object, test_object_connection
 
 
+def new_dbus_daemon_message(bus: SdBus, member: str) -> SdBusMessage:
+    return bus.new_method_call_message(
+        'org.freedesktop.DBus', '/org/freedesktop/DBus',
+        'org.freedesktop.DBus', member,
+    )
+
+
 class TestProxy(IsolatedDbusTestCase):
     async def asyncSetUp(self) -> None:
         await super().asyncSetUp()
@@ -919,3 +958,923 @@ class TestProxy(IsolatedDbusTestCase):
 
         class CombinedInterface(OneInterface, TwoInterface):
             ...
+
+
+class TestLocalProperties(IsolatedDbusTestCase):
+    async def asyncSetUp(self) -> None:
+        await super().asyncSetUp()
+        await self.bus.request_name_async(TEST_SERVICE_NAME, 0)
+
+    async def test_native_property(self) -> None:
+        class NativeInterface(
+            DbusInterfaceCommonAsync,
+            interface_name='org.example.native',
+        ):
+            def __init__(self) -> None:
+                super().__init__()
+                self.status_value = 1
+                self.state_value = 'starting'
+
+            @dbus_property_async(
+                'u',
+                flags=DbusPropertyEmitsChangeFlag,
+                native=True,
+            )
+            def status(self) -> int:
+                return self.status_value
+
+            @status.setter_private
+            def _status_setter(self, new_value: int) -> None:
+                self.status_value = new_value
+
+            @dbus_property_async('s', native=True)
+            def state(self) -> str:
+                return self.state_value
+
+            @state.setter_private
+            def _state_setter(self, new_value: str) -> None:
+                self.state_value = new_value
+
+        test_object = NativeInterface()
+        test_object.export_to_dbus('/')
+        test_object_connection = NativeInterface.new_proxy(
+            TEST_SERVICE_NAME, '/')
+
+        self.assertEqual(await test_object_connection.status, 1)
+        self.assertEqual(await test_object_connection.state, 'starting')
+
+        async with self.assertDbusSignalEmits(
+            test_object_connection.properties_changed
+        ) as properties_changed_record:
+            test_object.status.set_native(2)
+
+        properties_changed_record.assert_emitted_once_with(
+            ('org.example.native', {'Status': ('u', 2)}, []),
+        )
+        self.assertEqual(test_object.status_value, 2)
+        self.assertEqual(await test_object.status, 2)
+
+        test_object.state.set_native('running')
+        self.assertEqual(await test_object.state, 'running')
+        self.assertEqual(
+            await test_object_connection.properties_get_all_dict(),
+            {'status': 2, 'state': 'running'},
+        )
+
+        with self.assertRaises(OverflowError):
+            test_object.status.set_native(-1)
+
+        with self.assertRaises(DbusPropertyReadOnlyError):
+            await test_object_connection.status.set_async(3)
+
+        self.assertEqual(await test_object_connection.status, 2)
+
+        with self.assertRaises(TypeError):
+            class NoSetterInterface(
+                DbusInterfaceCommonAsync,
+                interface_name='org.example.native',
+            ):
+                @dbus_property_async('d', native=True)
+                def load(self) -> float:
+                    return 0.5
+
+    async def test_properties_snapshot(self) -> None:
+        def getter_not_used(message: SdBusMessage) -> None:
+            raise AssertionError
+
+        snapshot_calls: List[None] = []
+
+        def properties_snapshot() -> Dict[str, Any]:
+            snapshot_calls.append(None)
+            return {'TestProperty': 'snapshot', 'TestInt': 10}
+
+        interface = SdBusInterface()
+        interface.add_property('TestProperty', 's', getter_not_used, None, 0)
+        interface.add_property('TestInt', 'x', getter_not_used, None, 0)
+        interface.add_property(
+            'TestExplicit', 's', getter_not_used, None,
+            DbusPropertyExplicitFlag,
+        )
+        interface.add_native_property('TestNative', 'b', True, 0)
+        interface.set_properties_snapshot(properties_snapshot)
+        self.bus.add_interface(interface, '/snapshot', 'org.example.snapshot')
+
+        with self.assertRaises(RuntimeError):
+            interface.set_properties_snapshot(None)
+
+        def other_getter(message: SdBusMessage) -> None:
+            message.append_data('s', 'other')
+
+        other_interface = SdBusInterface()
+        other_interface.add_property(
+            'OtherProperty', 's', other_getter, None, 0)
+        self.bus.add_interface(
+            other_interface, '/snapshot', 'org.example.other')
+
+        test_object_connection = TestInterface.new_proxy(
+            TEST_SERVICE_NAME, '/snapshot')
+
+        self.assertEqual(
+            await test_object_connection._properties_get_all(
+                'org.example.snapshot'),
+            {
+                'TestProperty': ('s', 'snapshot'),
+                'TestInt': ('x', 10),
+                'TestNative': ('b', True),
+            },
+        )
+        self.assertEqual(len(snapshot_calls), 1)
+
+        # Other interfaces on the same path are served by sd-bus
+        self.assertEqual(
+            await test_object_connection._properties_get_all(
+                'org.example.other'),
+            {'OtherProperty': ('s', 'other')},
+        )
+        self.assertEqual(len(snapshot_calls), 1)
+
+        # Objects exported from Python use snapshots
+        test_object, test_object_connection = initialize_object()
+        self.assertEqual(
+            await test_object_connection.properties_get_all_dict(),
+            {
+                'test_property': 'test_property',
+                'test_property_read_only': 'read',
+                'test_property_private': 100,
+                'test_constant_property': 'a',
+            },
+        )
+
+    async def test_properties_changed_coalesced(self) -> None:
+        class BulkInterface(
+            DbusInterfaceCommonAsync,
+            interface_name='org.example.bulk',
+        ):
+            def __init__(self) -> None:
+                super().__init__()
+                self.values = {'a': 'a', 'b': 'b', 'large': ''}
+
+            @dbus_property_async('s')
+            def a(self) -> str:
+                return self.values['a']
+
+            @a.setter_private
+            def _a_setter(self, new_value: str) -> None:
+                self.values['a'] = new_value
+
+            @dbus_property_async('s')
+            def b(self) -> str:
+                return self.values['b']
+
+            @b.setter_private
+            def _b_setter(self, new_value: str) -> None:
+                self.values['b'] = new_value
+
+            @dbus_property_async('s', flags=DbusPropertyEmitsInvalidationFlag)
+            def large(self) -> str:
+                return self.values['large']
+
+            @large.setter_private
+            def _large_setter(self, new_value: str) -> None:
+                self.values['large'] = new_value
+
+        test_object = BulkInterface()
+        test_object.export_to_dbus('/bulk')
+        test_object_connection = BulkInterface.new_proxy(
+            TEST_SERVICE_NAME, '/bulk')
+
+        async with self.assertDbusSignalEmits(
+            test_object_connection.properties_changed
+        ) as properties_changed_record:
+            for i in range(10):
+                await test_object.a.set_async(str(i))
+            await test_object.b.set_async('new b')
+            await test_object.large.set_async('x' * 1000)
+
+        properties_changed_record.assert_emitted_once_with(
+            (
+                'org.example.bulk',
+                {'A': ('s', '9'), 'B': ('s', 'new b')},
+                ['Large'],
+            ),
+        )
+
+        async with self.assertDbusSignalEmits(
+            test_object_connection.properties_changed
+        ) as properties_changed_record:
+            # Same values as the last emitted are dropped
+            await test_object.a.set_async('9')
+            await test_object.b.set_async('changed')
+            await test_object.b.set_async('new b')
+            await test_object.large.set_async('y')
+
+        properties_changed_record.assert_emitted_once_with(
+            ('org.example.bulk', {}, ['Large']),
+        )
+
+    async def test_properties_changed_loop_stopped(self) -> None:
+        class StoppedInterface(
+            DbusInterfaceCommonAsync,
+            interface_name='org.example.stopped',
+        ):
+            def __init__(self) -> None:
+                super().__init__()
+                self.value = 'a'
+
+            @dbus_property_async('s')
+            def value_property(self) -> str:
+                return self.value
+
+            @value_property.setter_private
+            def _value_setter(self, new_value: str) -> None:
+                self.value = new_value
+
+        test_object = StoppedInterface()
+        test_object.export_to_dbus('/stopped')
+        test_object_connection = StoppedInterface.new_proxy(
+            TEST_SERVICE_NAME, '/stopped')
+
+        def change_in_stopped_loop() -> None:
+            other_loop = new_event_loop()
+
+            async def change() -> None:
+                # Loop stops before the emit scheduled by the change runs
+                other_loop.stop()
+                await test_object.value_property.set_async('lost')
+
+            other_loop.create_task(change())
+            other_loop.run_forever()
+            other_loop.close()
+
+        await get_running_loop().run_in_executor(None, change_in_stopped_loop)
+
+        async with self.assertDbusSignalEmits(
+            test_object_connection.properties_changed
+        ) as properties_changed_record:
+            await test_object.value_property.set_async('b')
+
+        properties_changed_record.assert_emitted_once_with(
+            ('org.example.stopped', {'ValueProperty': ('s', 'b')}, []),
+        )
+
+
+class TestDrive(IsolatedDbusTestCase):
+    async def _flood_signals(self, count: int) -> List[str]:
+        received: List[str] = []
+
+        def signal_callback(message: SdBusMessage) -> None:
+            received.append('signal')
+
+        self.slot = await self.bus.match_signal_async(
+            None, '/', 'org.example.test', 'Flood', signal_callback,
+        )
+
+        for _ in range(count):
+            self.bus.new_signal_message(
+                '/', 'org.example.test', 'Flood').send()
+
+        return received
+
+    async def test_drive_budget(self) -> None:
+        self.bus.drive_budget = 5
+        self.assertEqual(self.bus.drive_budget, 5)
+
+        events = await self._flood_signals(50)
+        # Blocking call reads every signal ahead of its reply
+        self.bus.call(new_dbus_daemon_message(self.bus, 'GetId'))
+        # Messages already read do not make the bus readable
+        self.bus.drive()
+
+        while events.count('signal') < 50:
+            await sleep(0)
+            events.append('tick')
+
+        longest_run = max(len(run) for run in ''.join(
+            'S' if event == 'signal' else ' ' for event in events).split())
+        # Reader callback and rescheduled drive can both run per iteration
+        self.assertLessEqual(longest_run, 10)
+
+    async def test_drive_prioritize_replies(self) -> None:
+        self.bus.drive_prioritize_replies = True
+        self.assertTrue(self.bus.drive_prioritize_replies)
+
+        received = await self._flood_signals(50)
+        ping_future = self.bus.call_async(
+            self.bus.new_method_call_message(
+                'org.freedesktop.DBus', '/org/freedesktop/DBus',
+                'org.freedesktop.DBus.Peer', 'Ping',
+            )
+        )
+        ping_future.add_done_callback(lambda _: received.append('reply'))
+        # Blocking call reads signals and the ping reply ahead of its
+        # own reply so signals are queued before the reply
+        self.bus.call(new_dbus_daemon_message(self.bus, 'GetId'))
+        self.bus.drive()
+
+        await wait_for(self._wait_signals(received, 51), timeout=1)
+        self.assertEqual(received[0], 'reply')
+
+    async def test_drive_flushes_write_queue(self) -> None:
+        server_socket, client_socket = socketpair()
+        with server_socket, client_socket:
+            server_bus = sd_bus_open_peer_fd(
+                server_socket.fileno(), server=True)
+            client_bus = sd_bus_open_peer_fd(client_socket.fileno())
+
+        test_object = TestInterface()
+        test_object.export_to_dbus('/', server_bus)
+        test_object_connection = TestInterface.new_proxy(
+            'org.example.peer', '/', client_bus)
+        self.assertEqual(
+            'PEER', await wait_for(test_object_connection.upper('peer'), 1))
+
+        # Server that does not read makes sends pile up in write queue
+        loop = get_running_loop()
+        self.assertTrue(loop.get_debug())
+        server_fd = server_bus.get_fd()
+        loop.remove_reader(server_fd)
+        server_bus.drive_time_budget_usec = 10000
+        client_bus.drive_time_budget_usec = 10000
+        with patch.object(getLogger('asyncio'), 'warning') as asyncio_warning:
+            large_data = 'x' * (256 * 1024)
+            for _ in range(16):
+                large_signal = client_bus.new_signal_message(
+                    '/', 'org.example.test', 'Large')
+                large_signal.append_data('s', large_data)
+                large_signal.send()
+
+            upper_task = loop.create_task(
+                test_object_connection.upper('last'))
+            await sleep(0)
+            self.assertFalse(upper_task.done())
+            loop.add_reader(server_fd, server_bus.drive)
+
+            # Nothing is received until the write queue is flushed
+            self.assertEqual('LAST', await wait_for(upper_task, timeout=5))
+
+        # Debug loop warns about callbacks slower than 0.1 seconds
+        asyncio_warning.assert_not_called()
+
+    async def test_cork(self) -> None:
+        # Finish connecting so sent messages are not held by sd-bus
+        await self.bus.call_async(new_dbus_daemon_message(self.bus, 'GetId'))
+        listener_bus = sd_bus_open_user()
+        received: List[str] = []
+
+        def signal_callback(message: SdBusMessage) -> None:
+            received.append(cast(str, message.get_contents()))
+
+        self.slot = await listener_bus.match_signal_async(
+            None, '/', 'org.example.test', 'Corked', signal_callback,
+        )
+
+        def send_signal(data: str) -> None:
+            signal_message = self.bus.new_signal_message(
+                '/', 'org.example.test', 'Corked')
+            signal_message.append_data('s', data)
+            signal_message.send()
+
+        self.bus.cork()
+        self.bus.cork()
+        send_signal('first')
+        self.bus.uncork()
+        send_signal('second')
+        await sleep(0.05)
+        self.assertEqual(received, [])
+
+        self.bus.uncork()
+        await wait_for(self._wait_signals(received, 2), timeout=1)
+        self.assertEqual(received, ['first', 'second'])
+
+        with self.assertRaises(RuntimeError):
+            self.bus.uncork()
+
+        # Call sends corked messages ahead of itself
+        self.bus.cork()
+        send_signal('third')
+        await self.bus.call_async(new_dbus_daemon_message(self.bus, 'GetId'))
+        await wait_for(self._wait_signals(received, 3), timeout=1)
+        self.bus.uncork()
+        self.assertEqual(received, ['first', 'second', 'third'])
+
+        self.bus.cork_sends = True
+        self.assertTrue(self.bus.cork_sends)
+        for i in range(100):
+            send_signal(str(i))
+        # Flushed at the end of loop iteration
+        await wait_for(self._wait_signals(received, 103), timeout=1)
+        self.assertEqual(received[3:], [str(i) for i in range(100)])
+
+    async def test_close_cancels_handles(self) -> None:
+        await self.bus.call_async(new_dbus_daemon_message(self.bus, 'GetId'))
+        references_count = getrefcount(self.bus)
+
+        self.bus.cork_sends = True
+        self.bus.new_signal_message(
+            '/', 'org.example.test', 'Corked').send()
+        self.assertGreater(getrefcount(self.bus), references_count)
+
+        # Cork handle and any armed drive or timer handle are released
+        self.bus.close()
+        self.assertLessEqual(getrefcount(self.bus), references_count)
+
+    async def _wait_signals(self, received: List[str], count: int) -> None:
+        while len(received) < count:
+            await sleep(0)
+
+    async def test_eager_dispatch(self) -> None:
+        if version_info < (3, 12):
+            with self.assertRaises(NotImplementedError):
+                self.bus.eager_dispatch = True
+            self.assertFalse(self.bus.eager_dispatch)
+            raise SkipTest('Task eager_start needs Python 3.12')
+
+        class EagerInterface(
+            DbusInterfaceCommonAsync,
+            interface_name='org.example.eager',
+        ):
+            def __init__(self) -> None:
+                super().__init__()
+                self.resume = Event()
+
+            @dbus_method_async(result_signature='b')
+            async def inline(self) -> bool:
+                # Timeouts need the current task before the first await
+                await wait_for(sleep(0), timeout=1)
+                return current_task() is not None
+
+            @dbus_method_async(result_signature='bs')
+            async def suspends(self) -> Tuple[bool, str]:
+                task_before_await = current_task()
+                await sleep(0)
+                await self.resume.wait()
+                return (
+                    task_before_await is not None
+                    and current_task() is task_before_await,
+                    get_current_message().sender or '',
+                )
+
+        await self.bus.request_name_async(TEST_SERVICE_NAME, 0)
+
+        test_object = EagerInterface()
+        test_object.export_to_dbus('/')
+        test_object_connection = EagerInterface.new_proxy(
+            TEST_SERVICE_NAME, '/')
+
+        loop = get_running_loop()
+        factory_tasks: List[Any] = []
+
+        def counting_task_factory(
+            loop: AbstractEventLoop,
+            coro: Any, /,
+            **kwargs: Any,
+        ) -> Task[Any]:
+            factory_tasks.append(coro)
+            return Task(coro, loop=loop, **kwargs)
+
+        self.addCleanup(loop.set_task_factory, loop.get_task_factory())
+        loop.set_task_factory(counting_task_factory)
+
+        async def count_call_tasks() -> int:
+            tasks_before = len(factory_tasks)
+            self.assertTrue(
+                await wait_for(test_object_connection.inline(), 1))
+            return len(factory_tasks) - tasks_before
+
+        regular_tasks = await count_call_tasks()
+        self.bus.eager_dispatch = True
+        self.assertTrue(self.bus.eager_dispatch)
+        # Eager task of the handler bypasses the loop task factory
+        self.assertLess(await count_call_tasks(), regular_tasks)
+
+        suspended_call = get_running_loop().create_task(
+            test_object_connection.suspends())
+        await sleep(0.05)
+        self.assertFalse(suspended_call.done())
+        test_object.resume.set()
+
+        same_task, sender = await wait_for(suspended_call, 1)
+        self.assertTrue(same_task)
+        self.assertTrue(sender)
+
+
+class TestPendingCall(IsolatedDbusTestCase):
+    async def test_pending_call(self) -> None:
+        pending_call = self.bus.call_async(
+            new_dbus_daemon_message(self.bus, 'GetId'))
+        self.assertIsInstance(pending_call, SdBusPendingCall)
+        self.assertTrue(isfuture(pending_call))
+        self.assertIs(pending_call.get_loop(), get_running_loop())
+        self.assertFalse(pending_call.done())
+
+        reply = await pending_call
+        self.assertTrue(pending_call.done())
+        self.assertIs(pending_call.result(), reply)
+        self.assertIsNone(pending_call.exception())
+        self.assertIsInstance(reply.get_contents(), str)
+
+        replies = await gather(
+            *(self.bus.call_async(new_dbus_daemon_message(self.bus, 'GetId'))
+              for _ in range(10))
+        )
+        self.assertEqual(len(set(r.get_contents() for r in replies)), 1)
+        self.assertEqual(self.bus.pending_calls, 0)
+        self.assertEqual(self.bus.cancelled_calls, 0)
+
+    async def test_call_many_async(self) -> None:
+        members = ['GetId', 'NoSuchMethod', 'GetId', 'ListNames']
+        results = await self.bus.call_many_async(
+            new_dbus_daemon_message(self.bus, member) for member in members
+        )
+
+        self.assertEqual(len(results), len(members))
+        first_reply, error, second_reply, names_reply = results
+        assert isinstance(first_reply, SdBusMessage)
+        assert isinstance(second_reply, SdBusMessage)
+        assert isinstance(names_reply, SdBusMessage)
+        self.assertIsInstance(error, DbusUnknownMethodError)
+        self.assertEqual(
+            first_reply.get_contents(), second_reply.get_contents())
+        self.assertIn('org.freedesktop.DBus', names_reply.get_contents())
+
+        self.assertEqual(await self.bus.call_many_async([]), [])
+        with self.assertRaises(TypeError):
+            self.bus.call_many_async(['GetId'])  # type: ignore[list-item]
+
+    async def test_pending_call_error(self) -> None:
+        pending_call = self.bus.call_async(
+            new_dbus_daemon_message(self.bus, 'NoSuchMethod'))
+        with self.assertRaises(DbusUnknownMethodError):
+            await pending_call
+
+        self.assertIsInstance(pending_call.exception(), DbusUnknownMethodError)
+
+    async def test_pending_call_error_not_retrieved(self) -> None:
+        from gc import collect
+
+        loop = get_running_loop()
+        errors: List[Dict[str, Any]] = []
+        self.addCleanup(loop.set_exception_handler,
+                        loop.get_exception_handler())
+        loop.set_exception_handler(
+            lambda loop, context: errors.append(context))
+
+        async def drop_call(retrieve: bool) -> None:
+            pending_call = self.bus.call_async(
+                new_dbus_daemon_message(self.bus, 'NoSuchMethod'))
+            call_done = Event()
+            pending_call.add_done_callback(lambda _: call_done.set())
+            await call_done.wait()
+            if retrieve:
+                self.assertIsInstance(
+                    pending_call.exception(), DbusUnknownMethodError)
+
+        await drop_call(retrieve=True)
+        collect()
+        self.assertEqual(errors, [])
+
+        await drop_call(retrieve=False)
+        collect()
+        self.assertEqual(len(errors), 1)
+        self.assertIn('never retrieved', errors[0]['message'])
+        self.assertIsInstance(errors[0]['exception'], DbusUnknownMethodError)
+
+    async def test_pending_call_cancel(self) -> None:
+        # Name owner is never processed so the call never gets a reply
+        unresponsive_bus = sd_bus_open_user()
+        unresponsive_bus.request_name('org.example.test', 0)
+
+        def unanswered_call() -> SdBusPendingCall:
+            return self.bus.call_async(
+                self.bus.new_method_call_message(
+                    'org.example.test', '/', 'org.example.test', 'Test',
+                )
+            )
+
+        pending_call = unanswered_call()
+        self.assertEqual(self.bus.pending_calls, 1)
+        with self.assertRaises(AsyncioTimeoutError):
+            await wait_for(pending_call, timeout=0.1)
+        self.assertTrue(pending_call.cancelled())
+        with self.assertRaises(CancelledError):
+            pending_call.result()
+        # Reply slot is released on cancel
+        self.assertEqual(self.bus.pending_calls, 0)
+        self.assertEqual(self.bus.cancelled_calls, 1)
+
+        async def await_call() -> None:
+            await unanswered_call()
+
+        task = get_running_loop().create_task(await_call())
+        await sleep(0)
+        task.cancel()
+        with self.assertRaises(CancelledError):
+            await task
+
+        self.assertEqual(self.bus.pending_calls, 0)
+        self.assertEqual(self.bus.cancelled_calls, 2)
+
+    async def test_pending_call_timeout(self) -> None:
+        # Name owner is never processed so the call never gets a reply
+        unresponsive_bus = sd_bus_open_user()
+        unresponsive_bus.request_name('org.example.test', 0)
+
+        def unanswered_message() -> SdBusMessage:
+            return self.bus.new_method_call_message(
+                'org.example.test', '/', 'org.example.test', 'Test',
+            )
+
+        call_start = monotonic()
+        with self.assertRaises(DbusNoReplyError):
+            await wait_for(
+                self.bus.call_async(
+                    unanswered_message(), timeout_usec=100_000),
+                timeout=1,
+            )
+
+        with self.assertRaises(DbusNoReplyError):
+            await wait_for(
+                self.bus.call_async(
+                    unanswered_message(),
+                    deadline_usec=int(monotonic() * 1_000_000) + 100_000,
+                ),
+                timeout=1,
+            )
+
+        # Earlier of timeout and deadline is used
+        with self.assertRaises(DbusNoReplyError):
+            await wait_for(
+                self.bus.call_async(
+                    unanswered_message(),
+                    timeout_usec=100_000,
+                    deadline_usec=int(monotonic() * 1_000_000) + 60_000_000,
+                ),
+                timeout=1,
+            )
+        self.assertLess(monotonic() - call_start, 1)
+
+        # Timer armed for a later deadline is moved to the earlier one
+        long_call = self.bus.call_async(
+            unanswered_message(), timeout_usec=60_000_000)
+        with self.assertRaises(DbusNoReplyError):
+            await wait_for(
+                self.bus.call_async(
+                    unanswered_message(), timeout_usec=100_000),
+                timeout=1,
+            )
+        long_call.cancel()
+
+        class UnresponsiveInterface(
+            DbusInterfaceCommonAsync,
+            interface_name='org.example.test',
+        ):
+            @dbus_method_async(timeout_usec=100_000)
+            async def test(self) -> None:
+                raise NotImplementedError
+
+        test_proxy = UnresponsiveInterface.new_proxy(
+            'org.example.test', '/', self.bus)
+        with self.assertRaises(DbusNoReplyError):
+            await wait_for(test_proxy.test(), timeout=1)
+
+
+class TestPeerToPeer(IsolatedDbusTestCase):
+    async def test_socketpair(self) -> None:
+        server_socket, client_socket = socketpair()
+        with server_socket, client_socket:
+            server_bus = sd_bus_open_peer_fd(
+                server_socket.fileno(), server=True)
+            client_bus = sd_bus_open_peer_fd(client_socket.fileno())
+
+        test_object = TestInterface()
+        test_object.export_to_dbus('/', server_bus)
+        # Peers have no names so any service name routes to the other end
+        test_object_connection = TestInterface.new_proxy(
+            'org.example.peer', '/', client_bus)
+
+        self.assertEqual(
+            'PEER', await wait_for(test_object_connection.upper('peer'), 1))
+        self.assertEqual(
+            test_object.test_string,
+            await wait_for(test_object_connection.test_property, 1),
+        )
+        self.assertEqual(await test_object_connection.get_sender(), '')
+
+        test_tuple = ('peer', 'signal')
+        async with self.assertDbusSignalEmits(
+            test_object_connection.test_signal
+        ) as remote_signals_record:
+            test_object.test_signal.emit(test_tuple)
+
+        remote_signals_record.assert_emitted_once_with(test_tuple)
+
+        with self.assertRaises(SdBusLibraryError):
+            await client_bus.request_name_async('org.example.peer', 0)
+
+    async def test_unix_socket_address(self) -> None:
+        with TemporaryDirectory() as temp_dir, \
+                socket(AF_UNIX, SOCK_STREAM) as listen_socket:
+            socket_path = f"{temp_dir}/peer.sock"
+            listen_socket.bind(socket_path)
+            listen_socket.listen()
+            listen_socket.setblocking(False)
+
+            client_bus = sd_bus_open_peer_address(f"unix:path={socket_path}")
+            accepted_socket, _ = await get_running_loop().sock_accept(
+                listen_socket)
+            with accepted_socket:
+                server_bus = sd_bus_open_peer_fd(
+                    accepted_socket.fileno(), server=True)
+
+        test_object = TestInterface()
+        test_object.export_to_dbus('/', server_bus)
+        test_object_connection = TestInterface.new_proxy(
+            'org.example.peer', '/', client_bus)
+
+        self.assertEqual(
+            'PEER', await wait_for(test_object_connection.upper('peer'), 1))
+
+    async def test_peer_server(self) -> None:
+        test_object = TestInterface()
+        server = DbusPeerServer({'/': test_object})
+
+        with TemporaryDirectory() as temp_dir:
+            socket_path = f"{temp_dir}/server.sock"
+            serve_task = get_running_loop().create_task(
+                server.serve_unix_socket(socket_path))
+            await sleep(0)
+
+            client_buses = [
+                sd_bus_open_peer_address(f"unix:path={socket_path}")
+                for _ in range(3)
+            ]
+            test_object_connections = [
+                TestInterface.new_proxy('org.example.peer', '/', client_bus)
+                for client_bus in client_buses
+            ]
+            self.assertEqual(
+                ['PEER'] * 3,
+                await wait_for(
+                    gather(
+                        *(connection.upper('peer')
+                          for connection in test_object_connections)
+                    ),
+                    1,
+                ),
+            )
+            self.assertEqual(len(server.connections), 3)
+
+            test_tuple = ('server', 'signal')
+            async with self.assertDbusSignalEmits(
+                test_object_connections[0].test_signal
+            ) as first_signals_record, self.assertDbusSignalEmits(
+                test_object_connections[2].test_signal
+            ) as last_signals_record:
+                test_object.test_signal.emit(test_tuple)
+
+            first_signals_record.assert_emitted_once_with(test_tuple)
+            last_signals_record.assert_emitted_once_with(test_tuple)
+
+            client_buses.pop().close()
+            while len(server.connections) != 2:
+                await sleep(0.01)
+
+            serve_task.cancel()
+            with self.assertRaises(CancelledError):
+                await serve_task
+
+            server.close()
+            self.assertEqual(server.connections, [])
+
+    async def test_peer_server_failed_connection(self) -> None:
+        class FailOnceInterface(TestInterface):
+            fail_export = True
+
+            def _export_to_peer_bus(
+                self,
+                object_path: str,
+                bus: SdBus,
+            ) -> None:
+                if self.fail_export:
+                    self.fail_export = False
+                    raise RuntimeError('Export failed')
+
+                super()._export_to_peer_bus(object_path, bus)
+
+        loop = get_running_loop()
+        errors: List[Dict[str, Any]] = []
+        self.addCleanup(loop.set_exception_handler,
+                        loop.get_exception_handler())
+        loop.set_exception_handler(
+            lambda loop, context: errors.append(context))
+
+        test_object = TestInterface()
+        server = DbusPeerServer({
+            '/': test_object,
+            '/failing': FailOnceInterface(),
+        })
+
+        with TemporaryDirectory() as temp_dir:
+            socket_path = f"{temp_dir}/server.sock"
+            serve_task = loop.create_task(
+                server.serve_unix_socket(socket_path))
+            await sleep(0)
+
+            failed_bus = sd_bus_open_peer_address(f"unix:path={socket_path}")
+            while not errors:
+                await sleep(0.01)
+
+            self.assertIsInstance(errors[0]['exception'], RuntimeError)
+            # Partially exported connection is removed
+            self.assertEqual(server.connections, [])
+            local_object_meta = test_object._dbus
+            assert isinstance(local_object_meta, DbusLocalObjectMeta)
+            self.assertEqual(local_object_meta.peer_buses_interfaces, {})
+
+            client_bus = sd_bus_open_peer_address(f"unix:path={socket_path}")
+            test_object_connection = TestInterface.new_proxy(
+                'org.example.peer', '/', client_bus)
+            self.assertEqual(
+                'PEER',
+                await wait_for(test_object_connection.upper('peer'), 1),
+            )
+            self.assertEqual(len(server.connections), 1)
+
+            serve_task.cancel()
+            with self.assertRaises(CancelledError):
+                await serve_task
+
+            server.close()
+            failed_bus.close()
+
+    async def test_peer_server_uid_check(self) -> None:
+        loop = get_running_loop()
+        errors: List[Dict[str, Any]] = []
+        self.addCleanup(loop.set_exception_handler,
+                        loop.get_exception_handler())
+        loop.set_exception_handler(
+            lambda loop, context: errors.append(context))
+
+        server = DbusPeerServer({'/': TestInterface()}, allowed_uids=())
+
+        with TemporaryDirectory() as temp_dir:
+            socket_path = f"{temp_dir}/server.sock"
+            serve_task = loop.create_task(
+                server.serve_unix_socket(socket_path))
+            await sleep(0)
+
+            rejected_bus = sd_bus_open_peer_address(
+                f"unix:path={socket_path}")
+            while not errors:
+                await sleep(0.01)
+
+            self.assertIsInstance(errors[0]['exception'], PermissionError)
+            self.assertEqual(server.connections, [])
+
+            serve_task.cancel()
+            with self.assertRaises(CancelledError):
+                await serve_task
+
+            rejected_bus.close()
+
+    async def test_peer_server_slow_connection(self) -> None:
+        class SlowFirstServer(DbusPeerServer):
+            first_connection = True
+
+            async def add_connection(self, connected_socket: socket) -> SdBus:
+                if self.first_connection:
+                    self.first_connection = False
+                    await resume_first.wait()
+                return await super().add_connection(connected_socket)
+
+        resume_first = Event()
+        server = SlowFirstServer({'/': TestInterface()})
+
+        with TemporaryDirectory() as temp_dir:
+            socket_path = f"{temp_dir}/server.sock"
+            serve_task = get_running_loop().create_task(
+                server.serve_unix_socket(socket_path))
+            await sleep(0)
+
+            # Connection still being set up does not block the others
+            slow_bus = sd_bus_open_peer_address(f"unix:path={socket_path}")
+            client_bus = sd_bus_open_peer_address(f"unix:path={socket_path}")
+            test_object_connection = TestInterface.new_proxy(
+                'org.example.peer', '/', client_bus)
+            self.assertEqual(
+                'PEER',
+                await wait_for(test_object_connection.upper('peer'), 1),
+            )
+            self.assertEqual(len(server.connections), 1)
+
+            resume_first.set()
+            while len(server.connections) != 2:
+                await sleep(0.01)
+
+            serve_task.cancel()
+            with self.assertRaises(CancelledError):
+                await serve_task
+
+            server.close()
+            slow_bus.close()
+            client_bus.close()
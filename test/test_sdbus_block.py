@@ -20,9 +20,17 @@
 
 from __future__ import annotations
 
+from threading import Event, Thread
+from time import monotonic, sleep
+from typing import List
 from unittest import main
 
-from sdbus.exceptions import DbusPropertyReadOnlyError
+from sdbus.exceptions import (
+    DbusPropertyReadOnlyError,
+    DbusTimeoutError,
+    DbusUnknownMethodError,
+)
+from sdbus.sd_bus_internals import SdBusMessage, sd_bus_open_user
 from sdbus.unittest import IsolatedDbusTestCase
 from sdbus_block.dbus_daemon import FreedesktopDbus
 
@@ -92,6 +100,145 @@ class TestSync(IsolatedDbusTestCase):
         class CombinedInterface(OneInterface, TwoInterface):
             ...
 
+    def test_blocking_call_releases_gil(self) -> None:
+        # Name is owned by self.bus which is never processed
+        self.bus.request_name('org.example.test', 0)
+        caller_bus = sd_bus_open_user()
+        caller_bus.method_call_timeout_usec = 300_000
+        message = caller_bus.new_method_call_message(
+            'org.example.test', '/', 'org.example.test', 'Test',
+        )
+
+        ping_proxy = FreedesktopDbus(sd_bus_open_user())
+        ping_proxy.dbus_ping()
+        start_ping = Event()
+        ping_times: List[float] = []
+
+        def ping_other_bus() -> None:
+            start_ping.wait()
+            # Let the main thread enter the blocking call
+            sleep(0.05)
+            ping_proxy.dbus_ping()
+            ping_times.append(monotonic())
+
+        ping_thread = Thread(target=ping_other_bus)
+        ping_thread.start()
+        start_ping.set()
+        with self.assertRaises(DbusTimeoutError):
+            caller_bus.call(message)
+        call_end = monotonic()
+        ping_thread.join()
+
+        self.assertEqual(len(ping_times), 1)
+        self.assertLess(ping_times[0], call_end)
+
+    def test_call_timeout(self) -> None:
+        # Name is owned by self.bus which is never processed
+        self.bus.request_name('org.example.test', 0)
+        caller_bus = sd_bus_open_user()
+
+        call_start = monotonic()
+        with self.assertRaises(DbusTimeoutError):
+            caller_bus.call(
+                caller_bus.new_method_call_message(
+                    'org.example.test', '/', 'org.example.test', 'Test',
+                ),
+                timeout_usec=100_000,
+            )
+
+        class UnresponsiveInterface(
+            DbusInterfaceCommon,
+            interface_name='org.example.test',
+        ):
+            @dbus_method(timeout_usec=100_000)
+            def test(self) -> None:
+                raise NotImplementedError
+
+        with self.assertRaises(DbusTimeoutError):
+            UnresponsiveInterface(
+                'org.example.test', '/', caller_bus).test()
+        self.assertLess(monotonic() - call_start, 1)
+
+    def test_call_many(self) -> None:
+        def dbus_message(member: str) -> SdBusMessage:
+            return self.bus.new_method_call_message(
+                'org.freedesktop.DBus', '/org/freedesktop/DBus',
+                'org.freedesktop.DBus', member,
+            )
+
+        results = self.bus.call_many(
+            dbus_message(member)
+            for member in ('GetId', 'NoSuchMethod', 'GetId')
+        )
+        self.assertEqual(len(results), 3)
+        first_reply, error, second_reply = results
+        assert isinstance(first_reply, SdBusMessage)
+        assert isinstance(second_reply, SdBusMessage)
+        self.assertIsInstance(error, DbusUnknownMethodError)
+        self.assertEqual(
+            first_reply.get_contents(), second_reply.get_contents())
+
+        many_results = self.bus.call_many(
+            dbus_message('GetId') for _ in range(500))
+        self.assertEqual(
+            set(r.get_contents() for r in many_results
+                if isinstance(r, SdBusMessage)),
+            {first_reply.get_contents()},
+        )
+        self.assertEqual(self.bus.call_many([]), [])
+
+        # Name is owned by a bus which is never processed
+        unresponsive_bus = sd_bus_open_user()
+        unresponsive_bus.request_name('org.example.test', 0)
+        call_start = monotonic()
+        timeout_results = self.bus.call_many(
+            [
+                self.bus.new_method_call_message(
+                    'org.example.test', '/', 'org.example.test', 'Test',
+                ),
+                dbus_message('GetId'),
+            ],
+            timeout_usec=100_000,
+        )
+        self.assertIsInstance(timeout_results[0], DbusTimeoutError)
+        self.assertIsInstance(timeout_results[1], SdBusMessage)
+        self.assertLess(monotonic() - call_start, 1)
+
+        # Bus default timeout is mapped same as SdBus.call
+        self.bus.method_call_timeout_usec = 100_000
+        with self.assertRaises(DbusTimeoutError):
+            self.bus.call(
+                self.bus.new_method_call_message(
+                    'org.example.test', '/', 'org.example.test', 'Test',
+                )
+            )
+        default_timeout_results = self.bus.call_many([
+            self.bus.new_method_call_message(
+                'org.example.test', '/', 'org.example.test', 'Test',
+            ),
+        ])
+        self.assertIsInstance(default_timeout_results[0], DbusTimeoutError)
+
+    def test_blocking_calls_shared_bus(self) -> None:
+        s = FreedesktopDbus(self.bus)
+        errors: List[BaseException] = []
+
+        def ping_many() -> None:
+            try:
+                for _ in range(50):
+                    s.dbus_ping()
+                    s.get_id()
+            except BaseException as e:
+                errors.append(e)
+
+        threads = [Thread(target=ping_many) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual(errors, [])
+
 
 if __name__ == '__main__':
     main()